@@ -52,6 +52,9 @@
 #define ACAPI_Notification_CatchSelectionChange ACAPI_Notify_CatchSelectionChange
 #define ACAPI_Notification_RegisterEventHandler ACAPI_Notify_RegisterEventHandler
 
+#define ACAPI_Element_CatchNewElement ACAPI_Notify_CatchNewElement
+#define ACAPI_Element_InstallElementObserver ACAPI_Notify_InstallElementObserver
+
 #define ACAPI_AddOnIntegration_RegisterFileType ACAPI_Register_FileType
 #define ACAPI_AddOnIntegration_InstallFileTypeHandler3D ACAPI_Install_FileTypeHandler3D
 #define ACAPI_AddOnIntegration_InstallModulCommandHandler ACAPI_Install_ModulCommandHandler
@@ -83,6 +86,8 @@
 #define ACAPI_LibraryManagement_OverwriteLibPart(par1) (ACAPI_Environment (APIEnv_OverwriteLibPartID, (void*)(par1), nullptr))
 #define ACAPI_LibraryManagement_GetLibraries(par1, par2) (ACAPI_Environment (APIEnv_GetLibrariesID, (void*)(par1), (void*)(par2)))
 #define ACAPI_LibraryManagement_SetLibraries(par1) (ACAPI_Environment (APIEnv_SetLibrariesID, (void*)(par1)))
+#define ACAPI_LibraryManagement_DeleteEmbeddedLibItem(par1, par2, par3) (ACAPI_Goodies (APIAny_DeleteEmbeddedLibItemID, (void*)(par1), (void*)(GS::IntPtr)(par2), (void*)(GS::IntPtr)(par3)))
+#define ACAPI_ProjectOperation_ReloadLibraries() (ACAPI_Automate (APIDo_ReloadLibrariesID))
 #define ACAPI_ProjectOperation_Project(par1) (ACAPI_Environment (APIEnv_ProjectID, (void*)(par1)))
 #define ACAPI_ProjectSetting_GetStorySettings(par1) (ACAPI_Environment (APIEnv_GetStorySettingsID, (void*)(par1)))
 #define ACAPI_ProjectSetting_ChangeStorySettings(par1) (ACAPI_Environment (APIEnv_ChangeStorySettingsID, (void*)(par1)))
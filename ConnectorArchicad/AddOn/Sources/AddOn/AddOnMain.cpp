@@ -2,10 +2,7 @@
 #include "ACAPinc.h"
 #include "APIMigrationHelper.hpp"
 
-#include "DGModule.hpp"
-#include "Process.hpp"
 #include "ResourceIds.hpp"
-#include "FileSystem.hpp"
 
 #include "Commands/GetModelForElements.hpp"
 #include "Commands/GetElementIds.hpp"
@@ -41,6 +38,15 @@
 #include "Commands/CreateDirectShape.hpp"
 #include "Commands/SelectElements.hpp"
 #include "Commands/FinishReceiveTransaction.hpp"
+#include "Commands/GetPerformanceStats.hpp"
+#include "Commands/ResetPerformanceStats.hpp"
+#include "Commands/TimedCommand.hpp"
+#include "Commands/GetChangesSince.hpp"
+#include "Commands/ConnectorHeartbeat.hpp"
+#include "Commands/RemoveUnusedLibraryParts.hpp"
+#include "ClassificationImportManager.hpp"
+#include "ChangeJournal.hpp"
+#include "AvaloniaProcessManager.hpp"
 
 
 #define CHECKERROR(f) { GSErrCode err = (f); if (err != NoError) { return err; } }
@@ -54,118 +60,6 @@ static const short AddOnMenuID = ID_ADDON_MENU;
 static const Int32 AddOnCommandID = 1;
 
 
-class AvaloniaProcessManager {
-public:
-	void Start ()
-	{
-		if (IsRunning ()) {
-			return;
-		}
-
-		try {
-			const GS::UniString command = GetPlatformSpecificExecutablePath ();
-			const GS::Array<GS::UniString> arguments = GetExecutableArguments ();
-
-			avaloniaProcess = GS::Process::Create (command, arguments);
-		} catch (GS::Exception&) {
-			DG::ErrorAlert ("Error", "Can't start Speckle UI", "OK");
-		}
-	}
-
-
-	void Stop ()
-	{
-		if (!IsRunning ()) {
-			return;
-		}
-
-		avaloniaProcess->Kill ();
-	}
-
-
-	bool IsRunning ()
-	{
-		return avaloniaProcess.HasValue () && !avaloniaProcess->IsTerminated ();
-	}
-
-
-private:
-	GS::UniString GetPlatformSpecificExecutablePath ()
-	{
-		IO::Location ownFileLoc;
-		auto err = ACAPI_GetOwnLocation (&ownFileLoc);
-		if (err != NoError) {
-			return "";
-		}
-
-#if defined (macintosh)
-		static const char* ProductionConnector = "../../../Common/ConnectorArchicad/ConnectorArchicad.app/Contents/MacOS/ConnectorArchicad";
-#else
-		static const char* ProductionConnector = "../../../Common/ConnectorArchicad/ConnectorArchicad.exe";
-#endif
-
-		IO::Location location (ownFileLoc);
-		location.AppendToLocal (IO::RelativeLocation (ProductionConnector));
-
-		bool exist (false);
-		err = IO::fileSystem.Contains (location, &exist);
-		if (err != NoError || !exist) {
-			location = ownFileLoc;
-
-#if defined (macintosh)
-#ifdef DEBUG
-			static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Debug/net6.0/ConnectorArchicad";
-#else
-			static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Release/net6.0/ConnectorArchicad";
-#endif
-#else
-#ifdef DEBUG
-			static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Debug/net6.0/ConnectorArchicad.exe";
-#else
-			static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Release/net6.0/ConnectorArchicad.exe";
-#endif
-#endif
-
-			location.AppendToLocal (IO::RelativeLocation (DevelopmentConnector));
-		}
-
-		GS::UniString executableStr;
-		location.ToPath (&executableStr);
-
-		return executableStr;
-	}
-
-
-	GS::Array<GS::UniString> GetExecutableArguments ()
-	{
-		UShort portNumber = 0;
-		{
-			const auto err = ACAPI_Command_GetHttpConnectionPort (&portNumber);
-
-			if (err != NoError) {
-				throw GS::IllegalArgumentException ();
-			}
-		}
-
-		UShort archicadVersion = 0;
-		{
-			API_ServerApplicationInfo serverApplicationInfo;
-			ACAPI_GetReleaseNumber (&serverApplicationInfo);
-
-			archicadVersion = serverApplicationInfo.mainVersion;
-		}
-
-		return GS::Array<GS::UniString> { GS::ValueToUniString (portNumber), GS::ValueToUniString (archicadVersion) };
-	}
-
-
-	GS::Optional<GS::Process> avaloniaProcess;
-
-};
-
-static AvaloniaProcessManager avaloniaProcess;
-
-
 static GSErrCode MenuCommandHandler (const API_MenuParams* menuParams)
 {
 	switch (menuParams->menuItemRef.menuResID) {
@@ -173,7 +67,7 @@ static GSErrCode MenuCommandHandler (const API_MenuParams* menuParams)
 		switch (menuParams->menuItemRef.itemIndex) {
 		case AddOnCommandID:
 		{
-			avaloniaProcess.Start ();
+			AvaloniaProcessManager::GetInstance ()->Show ();
 		}
 		break;
 		}
@@ -186,40 +80,45 @@ static GSErrCode MenuCommandHandler (const API_MenuParams* menuParams)
 
 static GSErrCode RegisterAddOnCommands ()
 {
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetModelForElements> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetElementIds> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetElementTypes> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetWallData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetDoorData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetWindowData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetBeamData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetColumnData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetElementBaseData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetGridElementData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetObjectData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetOpeningData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetRoofData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetShellData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetSkylightData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetSlabData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetProjectInfo> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetZoneData> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateWall> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateDoor> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateWindow> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateBeam> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateGridElement> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateColumn> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateObject> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateOpening> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateRoof> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateShell> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateSkylight> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateSlab> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateZone> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::CreateDirectShape> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::SelectElements> ()));
-	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::FinishReceiveTransaction> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetModelForElements>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetElementIds>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetElementTypes>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetWallData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetDoorData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetWindowData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetBeamData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetColumnData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetElementBaseData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetGridElementData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetObjectData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetOpeningData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetRoofData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetShellData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetSkylightData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetSlabData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetProjectInfo>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetZoneData>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateWall>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateDoor>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateWindow>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateBeam>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateGridElement>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateColumn>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateObject>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateOpening>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateRoof>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateShell>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateSkylight>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateSlab>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateZone>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::CreateDirectShape>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::SelectElements>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::FinishReceiveTransaction>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::GetChangesSince>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::ConnectorHeartbeat>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::TimedCommand<AddOnCommands::RemoveUnusedLibraryParts>> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::GetPerformanceStats> ()));
+	CHECKERROR (ACAPI_AddOnAddOnCommunication_InstallAddOnCommandHandler (NewOwned<AddOnCommands::ResetPerformanceStats> ()));
 
 	return NoError;
 }
@@ -244,9 +143,20 @@ GSErrCode __ACDLL_CALL RegisterInterface (void)
 }
 
 
+// an add-on has a single project event handler
+static GSErrCode __ACENV_CALL ProjectEventHandler (API_NotifyEventID notifID, Int32 param)
+{
+	ClassificationImportManager::ProjectEventHandler (notifID, param);
+	AvaloniaProcessManager::ProjectEventHandler (notifID, param);
+
+	return ChangeJournal::ProjectEventHandler (notifID, param);
+}
+
+
 GSErrCode __ACENV_CALL Initialize (void)
 {
 	CHECKERROR (RegisterAddOnCommands ());
+	CHECKERROR (ACAPI_ProjectOperation_CatchProjectEvent (APINotify_New | APINotify_NewAndReset | APINotify_Open | APINotify_Close | APINotify_Quit | APINotify_ReceiveChanges, ProjectEventHandler));
 
 	return ACAPI_MenuItem_InstallMenuHandler (AddOnMenuID, MenuCommandHandler);
 }
@@ -254,7 +164,10 @@ GSErrCode __ACENV_CALL Initialize (void)
 
 GSErrCode __ACENV_CALL FreeData (void)
 {
-	avaloniaProcess.Stop ();
+	AvaloniaProcessManager::GetInstance ()->Stop ();
+	AvaloniaProcessManager::DeleteInstance ();
+	ClassificationImportManager::DeleteInstance ();
+	ChangeJournal::DeleteInstance ();
 
 	return NoError;
 }
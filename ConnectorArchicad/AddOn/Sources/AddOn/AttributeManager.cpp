@@ -1,4 +1,5 @@
 #include "AttributeManager.hpp"
+#include "PerformanceStats.hpp"
 
 
 AttributeManager* AttributeManager::instance = nullptr;
@@ -38,6 +39,9 @@ GSErrCode AttributeManager::GetMaterial (const ModelInfo::Material& material, AP
 		attribute.header.uniStringNamePtr = &materialName;
 		attribute.header.typeID = API_MaterialID;
 
+		static PerformanceStats::Counter& attributeCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::AttributeApi);
+		PerformanceStats::ScopedTimer timer (attributeCounter);
+
 		GSErrCode err = ACAPI_Attribute_Get (&attribute);
 		if (NoError == err) {
 			cache.Add (key, attribute);
@@ -0,0 +1,222 @@
+#include "AvaloniaProcessManager.hpp"
+#include "APIMigrationHelper.hpp"
+
+#include "DGModule.hpp"
+#include "FileSystem.hpp"
+
+#include <cstdlib>
+
+
+static const char* PrewarmEnvironmentVariable = "SPECKLE_ARCHICAD_PREWARM";
+static const char* HiddenArgument = "hidden";
+static const UInt32 MaxFailedStarts = 3;
+
+
+AvaloniaProcessManager* AvaloniaProcessManager::instance = nullptr;
+
+AvaloniaProcessManager* AvaloniaProcessManager::GetInstance ()
+{
+	if (nullptr == instance) {
+		instance = new AvaloniaProcessManager;
+	}
+	return instance;
+}
+
+
+void AvaloniaProcessManager::DeleteInstance ()
+{
+	if (nullptr != instance) {
+		delete instance;
+		instance = nullptr;
+	}
+}
+
+
+AvaloniaProcessManager::AvaloniaProcessManager () :
+	hidden (false),
+	ready (false),
+	showRequested (false),
+	failedStarts (0)
+{
+}
+
+
+GSErrCode __ACENV_CALL AvaloniaProcessManager::ProjectEventHandler (API_NotifyEventID notifID, Int32 /*param*/)
+{
+	switch (notifID) {
+		case APINotify_Close:
+		case APINotify_Quit:
+			return NoError;
+		default:
+			// the first project is open, or a prewarmed connector may have died since the last event
+			GetInstance ()->Prewarm ();
+			return NoError;
+	}
+}
+
+
+/*!
+ Show the connector, a hidden connector is asked to show itself by the next heartbeat
+ */
+void AvaloniaProcessManager::Show ()
+{
+	if (!IsRunning ()) {
+		Start (false);
+		return;
+	}
+
+	if (hidden)
+		showRequested = true;
+}
+
+
+void AvaloniaProcessManager::Stop ()
+{
+	if (!IsRunning ()) {
+		return;
+	}
+
+	avaloniaProcess->Kill ();
+}
+
+
+bool AvaloniaProcessManager::IsRunning ()
+{
+	return avaloniaProcess.HasValue () && !avaloniaProcess->IsTerminated ();
+}
+
+
+/*!
+ Called by the ConnectorHeartbeat command, the first call is the readiness handshake of the connector
+ @return true if the connector should show its window
+ */
+bool AvaloniaProcessManager::OnHeartbeat ()
+{
+	ready = true;
+	failedStarts = 0;
+
+	if (!showRequested)
+		return false;
+
+	showRequested = false;
+	hidden = false;
+
+	return true;
+}
+
+
+bool AvaloniaProcessManager::IsPrewarmEnabled () const
+{
+	const char* value = std::getenv (PrewarmEnvironmentVariable);
+	return value != nullptr && value[0] != '\0' && value[0] != '0';
+}
+
+
+void AvaloniaProcessManager::Prewarm ()
+{
+	if (!IsPrewarmEnabled () || IsRunning ())
+		return;
+
+	// the previous hidden connector died before the handshake, don't start it again and again if it can't start
+	if (avaloniaProcess.HasValue () && hidden && !ready)
+		failedStarts++;
+
+	if (failedStarts >= MaxFailedStarts)
+		return;
+
+	Start (true);
+}
+
+
+void AvaloniaProcessManager::Start (bool startHidden)
+{
+	if (IsRunning ()) {
+		return;
+	}
+
+	try {
+		const GS::UniString command = GetPlatformSpecificExecutablePath ();
+		const GS::Array<GS::UniString> arguments = GetExecutableArguments (startHidden);
+
+		avaloniaProcess = GS::Process::Create (command, arguments);
+		hidden = startHidden;
+		ready = false;
+		showRequested = false;
+	} catch (GS::Exception&) {
+		if (!startHidden)
+			DG::ErrorAlert ("Error", "Can't start Speckle UI", "OK");
+	}
+}
+
+
+GS::UniString AvaloniaProcessManager::GetPlatformSpecificExecutablePath ()
+{
+	IO::Location ownFileLoc;
+	auto err = ACAPI_GetOwnLocation (&ownFileLoc);
+	if (err != NoError) {
+		return "";
+	}
+
+#if defined (macintosh)
+	static const char* ProductionConnector = "../../../Common/ConnectorArchicad/ConnectorArchicad.app/Contents/MacOS/ConnectorArchicad";
+#else
+	static const char* ProductionConnector = "../../../Common/ConnectorArchicad/ConnectorArchicad.exe";
+#endif
+
+	IO::Location location (ownFileLoc);
+	location.AppendToLocal (IO::RelativeLocation (ProductionConnector));
+
+	bool exist (false);
+	err = IO::fileSystem.Contains (location, &exist);
+	if (err != NoError || !exist) {
+		location = ownFileLoc;
+
+#if defined (macintosh)
+#ifdef DEBUG
+		static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Debug/net6.0/ConnectorArchicad";
+#else
+		static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Release/net6.0/ConnectorArchicad";
+#endif
+#else
+#ifdef DEBUG
+		static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Debug/net6.0/ConnectorArchicad.exe";
+#else
+		static const char* DevelopmentConnector = "../../../../ConnectorArchicad/bin/Release/net6.0/ConnectorArchicad.exe";
+#endif
+#endif
+
+		location.AppendToLocal (IO::RelativeLocation (DevelopmentConnector));
+	}
+
+	GS::UniString executableStr;
+	location.ToPath (&executableStr);
+
+	return executableStr;
+}
+
+
+GS::Array<GS::UniString> AvaloniaProcessManager::GetExecutableArguments (bool startHidden)
+{
+	UShort portNumber = 0;
+	{
+		const auto err = ACAPI_Command_GetHttpConnectionPort (&portNumber);
+
+		if (err != NoError) {
+			throw GS::IllegalArgumentException ();
+		}
+	}
+
+	UShort archicadVersion = 0;
+	{
+		API_ServerApplicationInfo serverApplicationInfo;
+		ACAPI_GetReleaseNumber (&serverApplicationInfo);
+
+		archicadVersion = serverApplicationInfo.mainVersion;
+	}
+
+	GS::Array<GS::UniString> arguments { GS::ValueToUniString (portNumber), GS::ValueToUniString (archicadVersion) };
+	if (startHidden)
+		arguments.Push (HiddenArgument);
+
+	return arguments;
+}
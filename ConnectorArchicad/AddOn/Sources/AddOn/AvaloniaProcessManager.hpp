@@ -0,0 +1,49 @@
+#ifndef AVALONIA_PROCESS_MANAGER_HPP
+#define AVALONIA_PROCESS_MANAGER_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+#include "Process.hpp"
+
+// Runs the connector UI process.
+// With the SPECKLE_ARCHICAD_PREWARM environment variable set, the connector is started hidden when a project is opened,
+// so the menu only has to show it. The hidden connector polls the ConnectorHeartbeat command, the first call tells that it is ready.
+// A hidden connector that has died is started again on the next project event.
+class AvaloniaProcessManager {
+private:
+	static AvaloniaProcessManager* instance;
+
+	GS::Optional<GS::Process>	avaloniaProcess;
+	bool						hidden;
+	bool						ready;
+	bool						showRequested;
+		///The number of hidden starts that died before they were ready, prewarming stops at MaxFailedStarts
+	UInt32						failedStarts;
+
+protected:
+	AvaloniaProcessManager ();
+
+public:
+	AvaloniaProcessManager (AvaloniaProcessManager&) = delete;
+	void		operator=(const AvaloniaProcessManager&) = delete;
+	static AvaloniaProcessManager*	GetInstance ();
+	static void						DeleteInstance ();
+
+	static GSErrCode __ACENV_CALL	ProjectEventHandler (API_NotifyEventID notifID, Int32 param);
+
+	void		Show ();
+	void		Stop ();
+	bool		IsRunning ();
+
+	bool		OnHeartbeat ();
+
+private:
+	bool		IsPrewarmEnabled () const;
+	void		Prewarm ();
+	void		Start (bool startHidden);
+
+	GS::UniString				GetPlatformSpecificExecutablePath ();
+	GS::Array<GS::UniString>	GetExecutableArguments (bool startHidden);
+};
+
+#endif
@@ -0,0 +1,40 @@
+#include "BodyEdges.hpp"
+
+
+BodyEdges::BodyEdges (void* bodyData) :
+	bodyData (bodyData)
+{
+}
+
+
+GS::UInt64 BodyEdges::EdgeKey (UInt32 startVertex, UInt32 endVertex)
+{
+	return (GS::UInt64 (startVertex) << 32) | GS::UInt64 (endVertex);
+}
+
+
+/*!
+ The body edge from a vertex to another, created on first use
+ @param startVertex The body vertex the edge starts at
+ @param endVertex The body vertex the edge ends at
+ @param edge The edge index, negative if the existing edge runs the other way (out)
+ @return An error code (NoError = success)
+ */
+GSErrCode BodyEdges::GetEdge (UInt32 startVertex, UInt32 endVertex, Int32& edge)
+{
+	if (edges.Get (EdgeKey (startVertex, endVertex), &edge))
+		return NoError;
+
+	if (edges.Get (EdgeKey (endVertex, startVertex), &edge)) {
+		edge = -edge;
+		return NoError;
+	}
+
+	GSErrCode err = ACAPI_Body_AddEdge (bodyData, startVertex, endVertex, edge);
+	if (err != NoError)
+		return err;
+
+	edges.Add (EdgeKey (startVertex, endVertex), edge);
+
+	return NoError;
+}
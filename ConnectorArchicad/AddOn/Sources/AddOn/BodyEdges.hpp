@@ -0,0 +1,24 @@
+#ifndef BODY_EDGES_HPP
+#define BODY_EDGES_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+
+
+// The edges of a body under construction.
+// An edge shared by two polygons is created only once, the second polygon refers to it with reversed orientation (negative index).
+class BodyEdges {
+private:
+	void*								bodyData;
+		///Body edge indices keyed by their start and end vertices
+	GS::HashTable<GS::UInt64, Int32>	edges;
+
+	static GS::UInt64	EdgeKey (UInt32 startVertex, UInt32 endVertex);
+
+public:
+	explicit BodyEdges (void* bodyData);
+
+	GSErrCode			GetEdge (UInt32 startVertex, UInt32 endVertex, Int32& edge);
+};
+
+#endif
@@ -0,0 +1,221 @@
+#include "ChangeJournal.hpp"
+
+#include "APIMigrationHelper.hpp"
+#include "Utility.hpp"
+
+
+ChangeJournal* ChangeJournal::instance = nullptr;
+
+ChangeJournal* ChangeJournal::GetInstance ()
+{
+	if (nullptr == instance) {
+		instance = new ChangeJournal;
+	}
+	return instance;
+}
+
+
+void ChangeJournal::DeleteInstance ()
+{
+	if (nullptr != instance) {
+		delete instance;
+		instance = nullptr;
+	}
+}
+
+
+ChangeJournal::ChangeJournal () :
+	journalId (APINULLGuid),
+	lastSequence (0),
+	lostSequence (0),
+	firstEntry (0),
+	started (false)
+{
+}
+
+
+static bool Is3DElement (const API_Elem_Head& header)
+{
+	return Utility::Get3DElementTypes ().Contains (Utility::GetElementType (header).typeID);
+}
+
+
+GSErrCode __ACENV_CALL ChangeJournal::ElementEventHandler (const API_NotifyElementType* elemType)
+{
+	if (nullptr == instance || nullptr == elemType || !Is3DElement (elemType->elemHead))
+		return NoError;
+
+	const API_Guid& guid = elemType->elemHead.guid;
+	switch (elemType->notifID) {
+		case APINotifyElement_New:
+		case APINotifyElement_Copy:
+		case APINotifyElement_Undo_Created:
+		case APINotifyElement_Redo_Created:
+			// the new elements are observed from now on, so their later changes are reported too
+			ACAPI_Element_AttachObserver (guid);
+			instance->Record (guid, Created);
+			break;
+		case APINotifyElement_Change:
+		case APINotifyElement_Edit:
+		case APINotifyElement_Undo_Modified:
+		case APINotifyElement_Redo_Modified:
+		case APINotifyElement_ClassificationChange:
+		case APINotifyElement_PropertyValueChange:
+			instance->Record (guid, Modified);
+			break;
+		case APINotifyElement_Delete:
+		case APINotifyElement_Undo_Deleted:
+		case APINotifyElement_Redo_Deleted:
+			instance->Record (guid, Deleted);
+			break;
+		default:
+			break;
+	}
+
+	return NoError;
+}
+
+
+GSErrCode __ACENV_CALL ChangeJournal::ProjectEventHandler (API_NotifyEventID notifID, Int32 /*param*/)
+{
+	if (nullptr == instance || !instance->started)
+		return NoError;
+
+	switch (notifID) {
+		case APINotify_New:
+		case APINotify_NewAndReset:
+		case APINotify_Open:
+			// another project, the sequences of the previous one mean nothing here
+			instance->Restart ();
+			return instance->ObserveElements ();
+		case APINotify_ReceiveChanges:
+			// the received changes are reported by the element observers, only the elements created by others are new to observe
+			return instance->ObserveElements ();
+		default:
+			instance->Restart ();
+			return NoError;
+	}
+}
+
+
+/*!
+ Install the element event handlers and observe the 3D elements of the current project,
+ the add-on stays loaded from then on, an unloaded add-on would lose its observers
+ @return An error code (NoError = success)
+ */
+GSErrCode ChangeJournal::Start ()
+{
+	Restart ();
+
+	GSErrCode err = ACAPI_Element_CatchNewElement (nullptr, ElementEventHandler);
+	if (err != NoError)
+		return err;
+
+	err = ACAPI_Element_InstallElementObserver (ElementEventHandler);
+	if (err != NoError)
+		return err;
+
+	err = ACAPI_KeepInMemory (true);
+	if (err != NoError)
+		return err;
+
+	started = true;
+
+	return ObserveElements ();
+}
+
+
+void ChangeJournal::Restart ()
+{
+	GS::Guid newJournalId;
+	newJournalId.Generate ();
+	journalId = GSGuid2APIGuid (newJournalId);
+
+	lostSequence = lastSequence;
+	entries.Clear ();
+	firstEntry = 0;
+}
+
+
+void ChangeJournal::Record (const API_Guid& guid, ChangeType type)
+{
+	Entry entry;
+	entry.sequence = ++lastSequence;
+	entry.guid = guid;
+	entry.type = type;
+
+	if (entries.GetSize () < Capacity) {
+		entries.Push (entry);
+		return;
+	}
+
+	// full, the oldest entry is overwritten
+	lostSequence = entries[firstEntry].sequence;
+	entries[firstEntry] = entry;
+	firstEntry = (firstEntry + 1) % Capacity;
+}
+
+
+GSErrCode ChangeJournal::ObserveElements () const
+{
+	for (API_ElemTypeID typeID : Utility::Get3DElementTypes ()) {
+		GS::Array<API_Guid> elementGuids;
+		GSErrCode err = ACAPI_Element_GetElemList (typeID, &elementGuids);
+		if (err != NoError)
+			continue;
+
+		for (const API_Guid& guid : elementGuids)
+			ACAPI_Element_AttachObserver (guid);
+	}
+
+	return NoError;
+}
+
+
+static void MergeChange (GS::HashTable<API_Guid, ChangeJournal::ChangeType>& changes, const API_Guid& guid, ChangeJournal::ChangeType type)
+{
+	ChangeJournal::ChangeType* previousType = changes.GetPtr (guid);
+	if (previousType == nullptr) {
+		changes.Add (guid, type);
+		return;
+	}
+
+	switch (*previousType) {
+		case ChangeJournal::Created:
+			// created and deleted since the last call, the caller has never seen it
+			if (type == ChangeJournal::Deleted)
+				changes.Delete (guid);
+			break;
+		case ChangeJournal::Modified:
+			if (type == ChangeJournal::Deleted)
+				*previousType = ChangeJournal::Deleted;
+			break;
+		case ChangeJournal::Deleted:
+			// deleted and restored by an undo
+			if (type != ChangeJournal::Deleted)
+				*previousType = ChangeJournal::Modified;
+			break;
+	}
+}
+
+
+/*!
+ Collect the net changes after a sequence
+ @param sinceJournalId The journal id returned together with the sequence
+ @param sinceSequence The last sequence the caller has seen
+ @param changes The change of each element since the sequence (out)
+ @return false if the changes are not known since the sequence, the caller has to do a full resync
+ */
+bool ChangeJournal::GetChangesSince (const API_Guid& sinceJournalId, GS::UInt64 sinceSequence, GS::HashTable<API_Guid, ChangeType>& changes) const
+{
+	if (!started || sinceJournalId != journalId || sinceSequence < lostSequence || sinceSequence > lastSequence)
+		return false;
+
+	for (UInt32 i = 0; i < entries.GetSize (); i++) {
+		const Entry& entry = entries[(firstEntry + i) % entries.GetSize ()];
+		if (entry.sequence > sinceSequence)
+			MergeChange (changes, entry.guid, entry.type);
+	}
+
+	return true;
+}
@@ -0,0 +1,64 @@
+#ifndef CHANGE_JOURNAL_HPP
+#define CHANGE_JOURNAL_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+
+// Bounded journal of the created, modified and deleted 3D elements.
+// Every change gets the next sequence number. A caller passes the last sequence it has seen together with the journal id,
+// and the journal tells when it can't answer, because the entries were overwritten or the journal was restarted for another project.
+// The journal is started by the first GetChangesSince command, the add-on does not observe the elements until a connector asks for the changes.
+class ChangeJournal {
+public:
+	enum ChangeType {
+		Created,
+		Modified,
+		Deleted
+	};
+
+	static const UInt32 Capacity = 100000;
+
+private:
+	struct Entry {
+		GS::UInt64	sequence = 0;
+		API_Guid	guid = APINULLGuid;
+		ChangeType	type = Modified;
+	};
+
+	static ChangeJournal* instance;
+
+	API_Guid			journalId;
+	GS::UInt64			lastSequence;
+		///Changes up to this sequence may be missing from the journal
+	GS::UInt64			lostSequence;
+	GS::Array<Entry>	entries;
+	UInt32				firstEntry;
+	bool				started;
+
+protected:
+	ChangeJournal ();
+
+public:
+	ChangeJournal (ChangeJournal&) = delete;
+	void		operator=(const ChangeJournal&) = delete;
+	static ChangeJournal*	GetInstance ();
+	static void				DeleteInstance ();
+
+	static GSErrCode __ACENV_CALL	ElementEventHandler (const API_NotifyElementType* elemType);
+	static GSErrCode __ACENV_CALL	ProjectEventHandler (API_NotifyEventID notifID, Int32 param);
+
+	GSErrCode			Start ();
+	bool				IsStarted () const { return started; }
+
+	const API_Guid&		GetJournalId () const { return journalId; }
+	GS::UInt64			GetLastSequence () const { return lastSequence; }
+
+	bool				GetChangesSince (const API_Guid& sinceJournalId, GS::UInt64 sinceSequence, GS::HashTable<API_Guid, ChangeType>& changes) const;
+
+private:
+	void				Restart ();
+	void				Record (const API_Guid& guid, ChangeType type);
+	GSErrCode			ObserveElements () const;
+};
+
+#endif
@@ -24,60 +24,185 @@ void ClassificationImportManager::DeleteInstance ()
 ClassificationImportManager::ClassificationImportManager () {}
 
 
-GSErrCode AddToCache (GS::Array<API_ClassificationItem> items, GS::HashTable<GS::UniString, API_Guid>& cache)
+GSErrCode __ACENV_CALL ClassificationImportManager::ProjectEventHandler (API_NotifyEventID /*notifID*/, Int32 /*param*/)
 {
+	// the classification systems belong to the project
+	if (nullptr != instance)
+		instance->Invalidate ();
+
+	return NoError;
+}
+
+
+void ClassificationImportManager::Invalidate ()
+{
+	cache.Clear ();
+}
+
+
+/*!
+ Look up the codes not found so far again, the user may have added them to the classification system since
+ */
+void ClassificationImportManager::ForgetMissingItems ()
+{
+	for (auto& systemIndex : cache)
+		systemIndex.value->missingCodes.Clear ();
+}
+
+
+GSErrCode ClassificationImportManager::GetSystemIndex (const GS::UniString& systemName, SystemIndex*& systemIndex)
+{
+	systemIndex = cache.GetPtr (systemName);
+	if (systemIndex != nullptr)
+		return NoError;
+
+	GS::Array<API_ClassificationSystem> systems;
+	GSErrCode err = ACAPI_Classification_GetClassificationSystems (systems);
+	if (err != NoError)
+		return err;
+
+	for (auto& system : systems) {
+		if (system.name == systemName) {
+			SystemIndex newIndex;
+			newIndex.systemGuid = system.guid;
+			cache.Add (systemName, newIndex);
+			systemIndex = cache.GetPtr (systemName);
+			return NoError;
+		}
+	}
+
+	return Cancel;
+}
+
+
+GSErrCode ClassificationImportManager::GetChildren (SystemIndex& systemIndex, const API_Guid& parentGuid, const GS::Array<API_ClassificationItem>*& children)
+{
+	children = systemIndex.children.GetPtr (parentGuid);
+	if (children != nullptr)
+		return NoError;
+
+	GS::Array<API_ClassificationItem> items;
+	GSErrCode err = NoError;
+	if (parentGuid == APINULLGuid)
+		err = ACAPI_Classification_GetClassificationSystemRootItems (systemIndex.systemGuid, items);
+	else
+		err = ACAPI_Classification_GetClassificationItemChildren (parentGuid, items);
+	if (err != NoError)
+		return err;
+
 	for (auto& item : items) {
-		cache.Add (item.id, item.guid);
-		
-		GS::Array<API_ClassificationItem> childrenItems;
-		GSErrCode err = ACAPI_Classification_GetClassificationItemChildren (item.guid, childrenItems);
+		if (!systemIndex.items.ContainsKey (item.id))
+			systemIndex.items.Add (item.id, item.guid);
+	}
+
+	systemIndex.children.Add (parentGuid, items);
+	children = systemIndex.children.GetPtr (parentGuid);
+
+	return NoError;
+}
+
+
+GSErrCode ClassificationImportManager::FindByPrefixPath (SystemIndex& systemIndex, const GS::UniString& code, API_Guid& itemGuid)
+{
+	// hierarchical codes (e.g. Ss > Ss_25 > Ss_25_10) contain the code of their parent, only that path is expanded
+	API_Guid parentGuid = APINULLGuid;
+	while (true) {
+		const GS::Array<API_ClassificationItem>* children = nullptr;
+		GSErrCode err = GetChildren (systemIndex, parentGuid, children);
 		if (err != NoError)
 			return err;
 
-		AddToCache (childrenItems, cache);
+		if (systemIndex.items.Get (code, &itemGuid))
+			return NoError;
+
+		API_Guid nextParentGuid = APINULLGuid;
+		USize longestPrefix = 0;
+		for (const auto& child : *children) {
+			if (child.id.GetLength () > longestPrefix && child.id.GetLength () < code.GetLength () && code.BeginsWith (child.id)) {
+				nextParentGuid = child.guid;
+				longestPrefix = child.id.GetLength ();
+			}
+		}
+
+		if (nextParentGuid == APINULLGuid)
+			return Error;
+
+		parentGuid = nextParentGuid;
+	}
+}
+
+
+GSErrCode ClassificationImportManager::AddAllItems (SystemIndex& systemIndex, const API_Guid& parentGuid)
+{
+	const GS::Array<API_ClassificationItem>* children = nullptr;
+	GSErrCode err = GetChildren (systemIndex, parentGuid, children);
+	if (err != NoError)
+		return err;
+
+	// the array can move while the children of the children are added
+	GS::Array<API_Guid> childGuids;
+	for (const auto& child : *children)
+		childGuids.Push (child.guid);
+
+	for (const API_Guid& childGuid : childGuids) {
+		err = AddAllItems (systemIndex, childGuid);
+		if (err != NoError)
+			return err;
 	}
-	
+
 	return NoError;
 }
 
 
-GSErrCode	ClassificationImportManager::GetItem (const GS::UniString& systemName, const GS::UniString& code, API_Guid& itemGuid)
+bool ClassificationImportManager::IsValid (const API_Guid& itemGuid, const GS::UniString& code) const
 {
-	GS::ErrCode err = NoError;
-
-	if (!cache.ContainsKey (systemName)) {
-		API_ClassificationSystem targetSystem{};
-		{
-			GS::Array<API_ClassificationSystem> systems;
-			err = ACAPI_Classification_GetClassificationSystems (systems);
-			if (err != NoError)
-				return err;
-
-			err = Cancel;
-			for (auto& system : systems) {
-				if (system.name == systemName) {
-					targetSystem = system;
-					err = NoError;
-					break;
-				}
-			}
-			
-			if (err != NoError)
-				return err;
-		}
+	API_ClassificationItem item;
+	item.guid = itemGuid;
+
+	return ACAPI_Classification_GetClassificationItem (item) == NoError && item.id == code;
+}
 
-		GS::Array<API_ClassificationItem> rootItems;
-		err = ACAPI_Classification_GetClassificationSystemRootItems (targetSystem.guid, rootItems);
+
+GSErrCode	ClassificationImportManager::GetItem (const GS::UniString& systemName, const GS::UniString& code, API_Guid& itemGuid)
+{
+	SystemIndex* systemIndex = nullptr;
+	GSErrCode err = GetSystemIndex (systemName, systemIndex);
+	if (err != NoError)
+		return err;
+
+	if (systemIndex->items.Get (code, &itemGuid)) {
+		if (IsValid (itemGuid, code))
+			return NoError;
+
+		// the classification system was edited since the index was built
+		cache.Delete (systemName);
+		err = GetSystemIndex (systemName, systemIndex);
 		if (err != NoError)
 			return err;
-		
-		GS::HashTable<GS::UniString, API_Guid> systemCache;
-		AddToCache (rootItems, systemCache);
-		cache.Add(systemName, systemCache);
 	}
-	
-	if (cache[systemName].Get (code, &itemGuid))
+
+	if (systemIndex->missingCodes.Contains (code))
+		return Error;
+
+	if (!systemIndex->complete && FindByPrefixPath (*systemIndex, code, itemGuid) == NoError)
 		return NoError;
 
+	// the codes are not hierarchical, or the item was added (by the user or an earlier receive) after its parent was expanded:
+	// index the whole system again
+	systemIndex->children.Clear ();
+	systemIndex->complete = false;
+
+	err = AddAllItems (*systemIndex, APINULLGuid);
+	if (err != NoError)
+		return err;
+
+	systemIndex->complete = true;
+
+	if (systemIndex->items.Get (code, &itemGuid))
+		return NoError;
+
+	// not in the system, the whole system is not walked again for this code
+	systemIndex->missingCodes.Add (code);
+
 	return Error;
 }
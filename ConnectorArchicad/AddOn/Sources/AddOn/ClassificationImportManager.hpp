@@ -3,11 +3,23 @@
 
 #include "ModelInfo.hpp"
 
+// Lookup of classification items by system name and item code.
+// The index is kept for the lifetime of the project and filled lazily, it is dropped on project events.
+// The codes not found in a system are remembered until the end of the receive, so each of them walks the system once.
 class ClassificationImportManager {
 private:
+	struct SystemIndex {
+		API_Guid												systemGuid = APINULLGuid;
+		GS::HashTable<GS::UniString, API_Guid>					items;
+			///Children of the expanded items, the root items are stored with APINULLGuid
+		GS::HashTable<API_Guid, GS::Array<API_ClassificationItem>>	children;
+		GS::HashSet<GS::UniString>								missingCodes;
+		bool													complete = false;
+	};
+
 	static ClassificationImportManager* instance;
 
-	GS::HashTable< GS::UniString, GS::HashTable<GS::UniString, API_Guid>> cache;
+	GS::HashTable<GS::UniString, SystemIndex> cache;
 
 protected:
 	ClassificationImportManager ();
@@ -18,7 +30,18 @@ public:
 	static ClassificationImportManager* GetInstance ();
 	static void					DeleteInstance ();
 
+	static GSErrCode __ACENV_CALL	ProjectEventHandler (API_NotifyEventID notifID, Int32 param);
+
 	GSErrCode	GetItem (const GS::UniString& systemName, const GS::UniString& itemID, API_Guid& itemGuid);
+	void		Invalidate ();
+	void		ForgetMissingItems ();
+
+private:
+	GSErrCode	GetSystemIndex (const GS::UniString& systemName, SystemIndex*& systemIndex);
+	GSErrCode	GetChildren (SystemIndex& systemIndex, const API_Guid& parentGuid, const GS::Array<API_ClassificationItem>*& children);
+	GSErrCode	FindByPrefixPath (SystemIndex& systemIndex, const GS::UniString& code, API_Guid& itemGuid);
+	GSErrCode	AddAllItems (SystemIndex& systemIndex, const API_Guid& parentGuid);
+	bool		IsValid (const API_Guid& itemGuid, const GS::UniString& code) const;
 };
 
 #endif
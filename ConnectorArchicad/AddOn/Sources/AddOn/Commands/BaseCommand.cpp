@@ -1,5 +1,7 @@
 #include "BaseCommand.hpp"
 #include "ResourceIds.hpp"
+#include "FieldNames.hpp"
+#include "ResponseEncoder.hpp"
 
 
 namespace AddOnCommands {
@@ -40,4 +42,52 @@ void BaseCommand::OnResponseValidationFailed (const GS::ObjectState& /*response*
 }
 
 
+// the process window and the break check are not for free, they are updated once per this many elements
+static const UInt32 ProgressReportInterval = 64;
+
+
+void BaseCommand::StartProgress (GS::ProcessControl& processControl, const GS::UniString& title, UInt32 total)
+{
+	processControl.SetNextProcessPhase (title, (Int32) total);
+	processControl.SetProcessValue (0);
+}
+
+
+/*!
+ Report the number of processed elements and check whether the user wants to stop
+ @param processControl The process control of the command
+ @param processed The number of elements processed so far
+ @return true if the command should stop
+ */
+bool BaseCommand::ReportProgress (GS::ProcessControl& processControl, UInt32 processed)
+{
+	if (processed % ProgressReportInterval != 0)
+		return false;
+
+	processControl.SetProcessValue ((Int32) processed);
+
+	return processControl.BreakPending ();
+}
+
+
+/*!
+ Encode the response as requested by the responseEncoding parameter
+ @param parameters The parameters of the command
+ @param response The response of the command
+ @return The encoded response, or the response itself if no encoding was requested or the encoding failed
+ */
+GS::ObjectState BaseCommand::EncodeResponse (const GS::ObjectState& parameters, const GS::ObjectState& response)
+{
+	GS::UniString encoding;
+	if (!parameters.Get (FieldNames::ResponseEncoding::ResponseEncoding, encoding) || encoding.IsEmpty ())
+		return response;
+
+	GS::ObjectState encodedResponse;
+	if (ResponseEncoder::Encode (encoding, response, encodedResponse) != NoError)
+		return response;
+
+	return encodedResponse;
+}
+
+
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "APIEnvir.h"
 #include "ACAPinc.h"
+#include "ProcessControl.hpp"
 
 
 namespace AddOnCommands {
@@ -19,6 +20,11 @@ public:
 #ifdef ServerMainVers_2600
 	virtual bool							IsProcessWindowVisible () const override { return true; }
 #endif
+
+protected:
+	static void								StartProgress (GS::ProcessControl& processControl, const GS::UniString& title, UInt32 total);
+	static bool								ReportProgress (GS::ProcessControl& processControl, UInt32 processed);
+	static GS::ObjectState					EncodeResponse (const GS::ObjectState& parameters, const GS::ObjectState& response);
 };
 
 
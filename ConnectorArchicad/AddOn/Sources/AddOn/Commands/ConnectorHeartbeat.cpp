@@ -0,0 +1,27 @@
+#include "ConnectorHeartbeat.hpp"
+#include "ResourceIds.hpp"
+#include "ObjectState.hpp"
+#include "FieldNames.hpp"
+#include "AvaloniaProcessManager.hpp"
+
+
+namespace AddOnCommands
+{
+
+
+GS::String ConnectorHeartbeat::GetName () const
+{
+	return ConnectorHeartbeatCommandName;
+}
+
+
+GS::ObjectState ConnectorHeartbeat::Execute (const GS::ObjectState& /*parameters*/, GS::ProcessControl& /*processControl*/) const
+{
+	GS::ObjectState result;
+	result.Add (FieldNames::Connector::Show, AvaloniaProcessManager::GetInstance ()->OnHeartbeat ());
+
+	return result;
+}
+
+
+}
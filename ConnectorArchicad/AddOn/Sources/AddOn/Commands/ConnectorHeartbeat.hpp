@@ -0,0 +1,20 @@
+#ifndef CONNECTOR_HEARTBEAT_HPP
+#define CONNECTOR_HEARTBEAT_HPP
+
+#include "BaseCommand.hpp"
+
+
+namespace AddOnCommands {
+
+
+class ConnectorHeartbeat : public BaseCommand {
+public:
+	virtual GS::String		GetName () const override;
+	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override;
+};
+
+
+}
+
+
+#endif
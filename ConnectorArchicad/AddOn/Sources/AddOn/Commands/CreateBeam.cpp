@@ -26,6 +26,7 @@ GS::UniString CreateBeam::GetUndoableCommandName () const
 
 
 GSErrCode CreateBeam::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& /*decoded*/,
 	API_Element& element,
 	API_Element& beamMask,
 	API_ElementMemo& memo,
@@ -29,6 +29,7 @@ GS::UniString CreateColumn::GetUndoableCommandName () const
 
 
 GSErrCode CreateColumn::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& /*decoded*/,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
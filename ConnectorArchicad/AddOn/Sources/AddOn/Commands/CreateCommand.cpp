@@ -9,8 +9,13 @@
 #include "OnExit.hpp"
 #include "ExchangeManager.hpp"
 #include "Database.hpp"
+#include "PerformanceStats.hpp"
 #include "Objects/Level.hpp"
 
+#include <chrono>
+#include <cstring>
+#include <utility>
+
 
 using namespace FieldNames;
 
@@ -21,6 +26,9 @@ GSErrCode CreateCommand::CreateNewElement (API_Element& element,
 	API_ElementMemo& elementMemo,
 	API_SubElement* marker /*= nullptr*/) const
 {
+	static PerformanceStats::Counter& elementChangeCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::ElementChangeApi);
+	PerformanceStats::ScopedTimer timer (elementChangeCounter);
+
 	if (marker != nullptr)
 		return ACAPI_Element_CreateExt (&element, &elementMemo, 1UL, marker);
 
@@ -33,10 +41,33 @@ GSErrCode CreateCommand::ModifyExistingElement (API_Element& element,
 	API_ElementMemo& memo,
 	GS::UInt64 memoMask) const
 {
+	static PerformanceStats::Counter& elementChangeCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::ElementChangeApi);
+	PerformanceStats::ScopedTimer timer (elementChangeCounter);
+
 	return ACAPI_Element_Change (&element, &elementMask, &memo, memoMask, true);
 }
 
 
+static bool HandlesEqual (GSConstHandle handle1, GSConstHandle handle2)
+{
+	if (handle1 == nullptr || handle2 == nullptr)
+		return handle1 == handle2;
+
+	GSSize size = BMGetHandleSize (handle1);
+	return size == BMGetHandleSize (handle2) && memcmp (*handle1, *handle2, size) == 0;
+}
+
+
+static bool PtrsEqual (GSConstPtr ptr1, GSConstPtr ptr2)
+{
+	if (ptr1 == nullptr || ptr2 == nullptr)
+		return ptr1 == ptr2;
+
+	GSSize size = BMGetPtrSize (ptr1);
+	return size == BMGetPtrSize (ptr2) && memcmp (ptr1, ptr2, size) == 0;
+}
+
+
 void CreateCommand::GetStoryFromObjectState (const GS::ObjectState& os, const double& elementLevel, short& floorIndex, double& relativeLevel) const
 {
 	Objects::Level level;
@@ -93,6 +124,87 @@ void CreateCommand::GetStoryFromObjectState (const GS::ObjectState& os, const do
 }
 
 
+/*!
+ Clear the mask of the fields which are the same in the element as in the project.
+ Only walls, slabs and zones are compared, their polygons are in the compared memo parts, the other element types are always changed.
+ The fields are compared as raw bytes, padding and unmasked bytes can only make an unchanged field look changed, never the reverse.
+ @param element The element to change, read from the project and updated with the received values
+ @param elementMask The mask of the received fields, the unchanged fields are cleared from it
+ @param memo The memo to change
+ @param memoMask The mask of the received memo parts, the unchanged parts are cleared from it
+ @return false if nothing has to be changed
+ */
+bool CreateCommand::RemoveUnchangedFields (const API_Element& element,
+	API_Element& elementMask,
+	const API_ElementMemo& memo,
+	GS::UInt64& memoMask) const
+{
+	const API_ElemTypeID typeID = Utility::GetElementType (element.header).typeID;
+	if (typeID != API_WallID && typeID != API_SlabID && typeID != API_ZoneID)
+		return true;
+
+	static PerformanceStats::Counter& elementGetCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::ElementGetApi);
+	PerformanceStats::ScopedTimer timer (elementGetCounter);
+
+	API_Element original{};
+	original.header.guid = element.header.guid;
+	if (ACAPI_Element_Get (&original) != NoError)
+		return true;
+
+	// A masked field starts at the beginning of a run of set mask bytes, and it can't reach beyond the start of the next run.
+	// The field is unchanged if the bytes up to the next run are the same, this holds whether the mask marks the first or all bytes of a field.
+	const char* elementBytes = reinterpret_cast<const char*> (&element);
+	const char* originalBytes = reinterpret_cast<const char*> (&original);
+	char* maskBytes = reinterpret_cast<char*> (&elementMask);
+	const size_t size = sizeof (API_Element);
+
+	bool hasChangedField = false;
+	size_t runStart = 0;
+	while (runStart < size) {
+		while (runStart < size && maskBytes[runStart] == 0)
+			runStart++;
+		if (runStart == size)
+			break;
+
+		size_t runEnd = runStart;
+		while (runEnd < size && maskBytes[runEnd] != 0)
+			runEnd++;
+
+		size_t nextRunStart = runEnd;
+		while (nextRunStart < size && maskBytes[nextRunStart] == 0)
+			nextRunStart++;
+
+		if (memcmp (elementBytes + runStart, originalBytes + runStart, nextRunStart - runStart) == 0)
+			memset (maskBytes + runStart, 0, runEnd - runStart);
+		else
+			hasChangedField = true;
+
+		runStart = nextRunStart;
+	}
+
+	if (memoMask != 0) {
+		API_ElementMemo originalMemo{};
+		if (ACAPI_Element_GetMemo (element.header.guid, &originalMemo, memoMask) == NoError) {
+			if ((memoMask & APIMemoMask_Polygon) != 0 &&
+				HandlesEqual ((GSConstHandle) memo.coords, (GSConstHandle) originalMemo.coords) &&
+				HandlesEqual ((GSConstHandle) memo.pends, (GSConstHandle) originalMemo.pends) &&
+				HandlesEqual ((GSConstHandle) memo.parcs, (GSConstHandle) originalMemo.parcs))
+				memoMask &= ~APIMemoMask_Polygon;
+
+			if ((memoMask & APIMemoMask_EdgeTrims) != 0 && HandlesEqual ((GSConstHandle) memo.edgeTrims, (GSConstHandle) originalMemo.edgeTrims))
+				memoMask &= ~APIMemoMask_EdgeTrims;
+
+			if ((memoMask & APIMemoMask_SideMaterials) != 0 && PtrsEqual ((GSConstPtr) memo.sideMaterials, (GSConstPtr) originalMemo.sideMaterials))
+				memoMask &= ~APIMemoMask_SideMaterials;
+
+			ACAPI_DisposeElemMemoHdls (&originalMemo);
+		}
+	}
+
+	return hasChangedField || memoMask != 0;
+}
+
+
 GSErrCode CreateCommand::GetElementBaseFromObjectState (const GS::ObjectState& os, API_Element& element, API_Element& elementMask) const
 {
 	GSErrCode err = NoError;
@@ -116,13 +228,67 @@ GSErrCode CreateCommand::GetElementBaseFromObjectState (const GS::ObjectState& o
 }
 
 
-GS::ObjectState CreateCommand::Execute (const GS::ObjectState& parameters, GS::ProcessControl& /*processControl*/) const
+void CreateCommand::GetShapeFromObjectState (const GS::ObjectState& os, DecodedObjectState& decoded, const char* fieldName, Objects::ElementShape& shape)
+{
+	// already decoded before the undoable command, every shape is consumed once
+	Objects::ElementShape* decodedShape = decoded.shapes.GetPtr (fieldName);
+	if (decodedShape != nullptr) {
+		shape = std::move (*decodedShape);
+		decoded.shapes.Delete (fieldName);
+		return;
+	}
+
+	os.Get (fieldName, shape);
+}
+
+
+void CreateCommand::DecodeObjectState (const GS::ObjectState& os, DecodedObjectState& decoded)
+{
+	os.Get (ElementBase::Id, decoded.speckleId);
+	os.Get (ElementBase::ApplicationId, decoded.applicationId);
+
+	for (const char* fieldName : { ElementBase::Shape, ElementBase::Shape1, ElementBase::Shape2 }) {
+		if (!os.Contains (fieldName))
+			continue;
+
+		Objects::ElementShape shape;
+		os.Get (fieldName, shape);
+		decoded.shapes.Add (fieldName, std::move (shape));
+	}
+}
+
+
+// GS::ObjectState and the GS containers are not documented to be thread safe, the object states are decoded on the main thread
+void CreateCommand::DecodeObjectStates (const GS::Array<GS::ObjectState>& objectStates, GS::Array<DecodedObjectState>& decodedObjectStates)
+{
+	const UInt32 count = objectStates.GetSize ();
+	decodedObjectStates.Clear ();
+	decodedObjectStates.SetSize (count);
+
+	for (UInt32 i = 0; i < count; i++)
+		DecodeObjectState (objectStates[i], decodedObjectStates[i]);
+}
+
+
+GS::ObjectState CreateCommand::Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const
 {
 	GS::ObjectState result;
 
 	GS::Array<GS::ObjectState> objectStates;
 	parameters.Get (GetFieldName (), objectStates);
 
+	// decoding stage: pure data transformation, runs before the undoable command is opened
+	const auto decodeStart = std::chrono::steady_clock::now ();
+
+	GS::Array<DecodedObjectState> decodedObjectStates;
+	DecodeObjectStates (objectStates, decodedObjectStates);
+
+	ClassificationImportStats classificationImportStats;
+	ElementUpdateStats elementUpdateStats;
+	bool cancelled = false;
+
+	const auto applyStart = std::chrono::steady_clock::now ();
+
 	ACAPI_CallUndoableCommand (GetUndoableCommandName (), [&] () -> GSErrCode {
 		LibraryHelper helper (false);
 
@@ -134,7 +300,20 @@ GS::ObjectState CreateCommand::Execute (const GS::ObjectState& parameters, GS::P
 		Utility::Database db;
 		db.SwitchToFloorPlan ();
 
-		for (const GS::ObjectState& objectState : objectStates) {
+		ClassificationTargetCache classificationTargetCache;
+
+		StartProgress (processControl, GetUndoableCommandName (), objectStates.GetSize ());
+
+		for (UInt32 objectIndex = 0; objectIndex < objectStates.GetSize (); objectIndex++) {
+			// the elements processed so far are kept and reported
+			if (ReportProgress (processControl, objectIndex)) {
+				cancelled = true;
+				break;
+			}
+
+			const GS::ObjectState& objectState = objectStates[objectIndex];
+			DecodedObjectState& decodedObjectState = decodedObjectStates[objectIndex];
+
 			API_Element element{};
 			API_Element elementMask{};
 			API_ElementMemo memo{};
@@ -149,13 +328,9 @@ GS::ObjectState CreateCommand::Execute (const GS::ObjectState& parameters, GS::P
 
 			GSErrCode err = NoError;
 
-			GS::String speckleId;
-			{
-				objectState.Get (ElementBase::Id, speckleId);
-
-				if (speckleId.IsEmpty ())
-					err = Error;
-			}
+			const GS::String& speckleId = decodedObjectState.speckleId;
+			if (speckleId.IsEmpty ())
+				err = Error;
 
 			bool elementExists = false;
 			GS::Array<GS::UniString> log;
@@ -174,23 +349,28 @@ GS::ObjectState CreateCommand::Execute (const GS::ObjectState& parameters, GS::P
 					}
 					// otherwise try to use applicationId
 					else {
-						GS::UniString applicationId;
-						objectState.Get (ElementBase::ApplicationId, applicationId);
-						element.header.guid = APIGuidFromString (applicationId.ToCStr ());
+						element.header.guid = APIGuidFromString (decodedObjectState.applicationId.ToCStr ());
 					}
 				}
 
-				err = GetElementFromObjectState (objectState, element, elementMask, memo, memoMask, &marker, *attributeManager, *libpartImportManager, log);
+				err = GetElementFromObjectState (objectState, decodedObjectState, element, elementMask, memo, memoMask, &marker, *attributeManager, *libpartImportManager, log);
+
 				if (err == NoError) {
 					if (elementExists) {
-						err = ModifyExistingElement (element, elementMask, memo, memoMask);
+						if (RemoveUnchangedFields (element, elementMask, memo, memoMask)) {
+							err = ModifyExistingElement (element, elementMask, memo, memoMask);
+							if (err == NoError)
+								elementUpdateStats.changed++;
+						} else {
+							elementUpdateStats.skipped++;
+						}
 					} else {
 						err = CreateNewElement (element, memo, marker);
 					}
 				}
 
 				if (err == NoError) {
-					err = ImportClassificationsAndProperties (objectState, element.header.guid);
+					err = ImportClassificationsAndProperties (objectState, element.header.guid, classificationTargetCache, classificationImportStats);
 					if (err != NoError)
 						err = NoError;  // don't fail because of classification systems
 				}
@@ -221,20 +401,81 @@ GS::ObjectState CreateCommand::Execute (const GS::ObjectState& parameters, GS::P
 		}
 
 		result.Add (ApplicationObject::ApplicationObjects, applicationObjects);
+		if (cancelled)
+			result.Add (Cancelled, true);
 
 		return NoError;
 	});
 
+	const auto applyEnd = std::chrono::steady_clock::now ();
+
+	GS::ObjectState stageTimings;
+	stageTimings.Add (StageTimings::DecodeTime, std::chrono::duration<double, std::milli> (applyStart - decodeStart).count ());
+	stageTimings.Add (StageTimings::ApplyTime, std::chrono::duration<double, std::milli> (applyEnd - applyStart).count ());
+	result.Add (StageTimings::StageTimings, stageTimings);
+
+	GS::ObjectState classificationImport;
+	classificationImport.Add (ClassificationImport::Skipped, classificationImportStats.skipped);
+	classificationImport.Add (ClassificationImport::Applied, classificationImportStats.applied);
+	result.Add (ClassificationImport::ClassificationImport, classificationImport);
+
+	GS::ObjectState elementUpdates;
+	elementUpdates.Add (ElementUpdates::Skipped, elementUpdateStats.skipped);
+	elementUpdates.Add (ElementUpdates::Changed, elementUpdateStats.changed);
+	result.Add (ElementUpdates::ElementUpdates, elementUpdates);
+
 	return result;
 }
 
 
-GSErrCode CreateCommand::ImportClassificationsAndProperties (const GS::ObjectState& os, API_Guid& elemGuid) const
+GSErrCode CreateCommand::ImportClassificationsAndProperties (const GS::ObjectState& os,
+	API_Guid& elemGuid,
+	ClassificationTargetCache& targetCache,
+	ClassificationImportStats& stats) const
 {
+	static PerformanceStats::Counter& classificationCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::ClassificationApi);
+	PerformanceStats::ScopedTimer timer (classificationCounter);
+
 	GSErrCode err = NoError;
 	GS::Array<GS::ObjectState> classifications;
 	os.Get (FieldNames::ElementBase::Classifications, classifications);
 
+	// the same few classifications are assigned to many elements, resolve each distinct list once
+	GS::UniString targetKey;
+	GS::Array<GS::Pair<GS::UniString, GS::UniString>> systemCodePairs;
+	{
+		GS::UniString code;
+		GS::UniString system;
+		for (auto& classification : classifications) {
+			classification.Get (FieldNames::ElementBase::Classification::System, system);
+			classification.Get (FieldNames::ElementBase::Classification::Code, code);
+
+			targetKey += system + "\n" + code + "\n";
+			systemCodePairs.Push (GS::Pair<GS::UniString, GS::UniString> (system, code));
+		}
+	}
+
+	const GS::Pair<GSErrCode, GS::HashSet<API_Guid>>* target = targetCache.GetPtr (targetKey);
+	if (target == nullptr) {
+		GS::Pair<GSErrCode, GS::HashSet<API_Guid>> newTarget (NoError, GS::HashSet<API_Guid> ());
+		for (auto& systemCodePair : systemCodePairs) {
+			API_Guid itemGuid;
+			newTarget.first = ClassificationImportManager::GetInstance ()->GetItem (systemCodePair.first, systemCodePair.second, itemGuid);
+			if (newTarget.first != NoError)
+				break;
+
+			newTarget.second.Add (itemGuid);
+		}
+
+		targetCache.Add (targetKey, newTarget);
+		target = targetCache.GetPtr (targetKey);
+	}
+
+	if (target->first != NoError)
+		return target->first;
+
+	const GS::HashSet<API_Guid>& classificationItemsInSpeckle = target->second;
+
 	// store guids of the Archicad classification items in a set
 	GS::HashSet<API_Guid> classificationItemsInArchicad;
 	{
@@ -248,39 +489,40 @@ GSErrCode CreateCommand::ImportClassificationsAndProperties (const GS::ObjectSta
 		}
 	}
 
-	// store guids of the Speckle classification items in a set
-	GS::HashSet<API_Guid> classificationItemsInSpekcle;
-	{
-		GS::UniString code;
-		GS::UniString system;
-		GS::UniString name;
-		for (auto& classification : classifications) {
-			API_Guid itemGuid;
-			classification.Get (FieldNames::ElementBase::Classification::System, system);
-			classification.Get (FieldNames::ElementBase::Classification::Code, code);
-			classification.Get (FieldNames::ElementBase::Classification::Name, name); // for later usage
+	GS::Array<API_Guid> itemsToRemove;
+	for (const API_Guid& itemGuid : classificationItemsInArchicad) {
+		if (!classificationItemsInSpeckle.Contains (itemGuid))
+			itemsToRemove.Push (itemGuid);
+	}
 
-			err = ClassificationImportManager::GetInstance ()->GetItem (system, code, itemGuid);
-			if (err != NoError)
-				return err;
-			classificationItemsInSpekcle.Add (itemGuid);
-		}
+	GS::Array<API_Guid> itemsToAdd;
+	for (const API_Guid& itemGuid : classificationItemsInSpeckle) {
+		if (!classificationItemsInArchicad.Contains (itemGuid))
+			itemsToAdd.Push (itemGuid);
+	}
+
+	// already classified as received
+	if (itemsToRemove.IsEmpty () && itemsToAdd.IsEmpty ()) {
+		stats.skipped++;
+		return NoError;
 	}
 
 	// in Archicad but not in Speckle
-	for (auto& itemGuid : classificationItemsInArchicad.Where ([&] (const API_Guid& guid) { return !classificationItemsInSpekcle.Contains(guid); })) {
+	for (const API_Guid& itemGuid : itemsToRemove) {
 		err = ACAPI_Element_RemoveClassificationItem (elemGuid, itemGuid);
 		if (err != NoError)
 			return err;
 	}
 
 	// in Speckle but not in Archicad
-	for (auto& itemGuid : classificationItemsInSpekcle.Where ([&] (const API_Guid& guid) { return !classificationItemsInArchicad.Contains(guid); })) {
+	for (const API_Guid& itemGuid : itemsToAdd) {
 		err = ACAPI_Element_AddClassificationItem (elemGuid, itemGuid);
 		if (err != NoError)
 			return err;
 	}
 
+	stats.applied++;
+
 	return err;
 }
 
@@ -4,6 +4,7 @@
 #include "APIEnvir.h"
 #include "ACAPinc.h"
 #include "LibpartImportManager.hpp"
+#include "Objects/Polyline.hpp"
 
 #include "BaseCommand.hpp"
 
@@ -11,6 +12,18 @@ namespace AddOnCommands {
 
 
 class CreateCommand : public BaseCommand {
+public:
+	// the result of the decoding stage, filled in without calling the API
+	struct DecodedObjectState {
+		GS::String										speckleId;
+		GS::UniString									applicationId;
+		GS::HashTable<GS::String, Objects::ElementShape>	shapes;
+	};
+
+private:
+	static void				DecodeObjectState (const GS::ObjectState& os, DecodedObjectState& decoded);
+	static void				DecodeObjectStates (const GS::Array<GS::ObjectState>& objectStates, GS::Array<DecodedObjectState>& decodedObjectStates);
+
 	virtual GS::String		GetFieldName () const = 0;
 	virtual GS::UniString	GetUndoableCommandName () const = 0;
 
@@ -24,6 +37,7 @@ class CreateCommand : public BaseCommand {
 								GS::UInt64 memoMask) const;
 
 	virtual GSErrCode		GetElementFromObjectState (const GS::ObjectState& os,
+								DecodedObjectState& decoded,
 								API_Element& element,
 								API_Element& elementMask,
 								API_ElementMemo& memo,
@@ -43,10 +57,37 @@ protected:
 								API_Element& element,
 								API_Element& elementMask) const;
 
+	bool					RemoveUnchangedFields (const API_Element& element,
+								API_Element& elementMask,
+								const API_ElementMemo& memo,
+								GS::UInt64& memoMask) const;
+
+	static void				GetShapeFromObjectState (const GS::ObjectState& os,
+								DecodedObjectState& decoded,
+								const char* fieldName,
+								Objects::ElementShape& shape);
+
 public:
 	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override;
 
-	GSErrCode				ImportClassificationsAndProperties (const GS::ObjectState& os, API_Guid& elemGuid) const;
+	// target classification items keyed by the system and code list of the incoming element
+	using ClassificationTargetCache = GS::HashTable<GS::UniString, GS::Pair<GSErrCode, GS::HashSet<API_Guid>>>;
+
+	struct ClassificationImportStats {
+		UInt32	skipped = 0;
+		UInt32	applied = 0;
+	};
+
+	// existing elements left untouched because none of the received fields differ
+	struct ElementUpdateStats {
+		UInt32	skipped = 0;
+		UInt32	changed = 0;
+	};
+
+	GSErrCode				ImportClassificationsAndProperties (const GS::ObjectState& os,
+								API_Guid& elemGuid,
+								ClassificationTargetCache& targetCache,
+								ClassificationImportStats& stats) const;
 };
 }
 
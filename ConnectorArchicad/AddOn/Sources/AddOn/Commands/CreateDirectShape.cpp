@@ -8,6 +8,7 @@
 #include "FieldNames.hpp"
 #include "OnExit.hpp"
 #include "AttributeManager.hpp"
+#include "BodyEdges.hpp"
 using namespace FieldNames;
 
 
@@ -28,6 +29,7 @@ GS::UniString CreateDirectShape::GetUndoableCommandName () const
 
 
 GSErrCode CreateDirectShape::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& /*decoded*/,
 	API_Element& element,
 	API_Element& /*elementMask*/,
 	API_ElementMemo& memo,
@@ -55,35 +57,52 @@ GSErrCode CreateDirectShape::GetElementFromObjectState (const GS::ObjectState& o
 
 	const GS::Array<ModelInfo::Vertex>& vertices = modelInfo.GetVertices ();
 	GS::Array<UInt32> bodyVertices;
+	bodyVertices.SetCapacity (vertices.GetSize ());
 	for (UInt32 i = 0; i < vertices.GetSize (); i++) {
 		UInt32 bodyVertex = 0;
 		ACAPI_Body_AddVertex (bodyData, API_Coord3D{vertices[i].GetX (), vertices[i].GetY (), vertices[i].GetZ ()}, bodyVertex);
 		bodyVertices.Push (bodyVertex);
 	}
 
+	// resolve the materials of the model once, polygons only refer to them by index
+	const GS::Array<ModelInfo::Material>& materials = modelInfo.GetMaterials ();
+	GS::Array<API_OverriddenAttribute> materialOverrides;
+	materialOverrides.SetCapacity (materials.GetSize ());
+	for (const auto& material : materials) {
+		API_OverriddenAttribute overrideMaterial{};
+		API_Attribute materialAttribute;
+		if (NoError == attributeManager.GetMaterial (material, materialAttribute)) {
+			SetAPIOverriddenAttribute (overrideMaterial, materialAttribute.header.index);
+		}
+
+		materialOverrides.Push (overrideMaterial);
+	}
+
+	// edges shared by two polygons are created only once
+	BodyEdges bodyEdges (bodyData);
+
 	for (const auto& polygon : modelInfo.GetPolygons ()) {
 		UInt32 bodyPolygon = 0;
-		Int32 bodyEdge = 0;
 
-		GS::Array<Int32> polygonEdges;
 		const GS::Array<Int32>& pointIds = polygon.GetPointIds ();
+		GS::Array<Int32> polygonEdges;
+		polygonEdges.SetCapacity (pointIds.GetSize ());
 		for (UInt32 i = 0; i < pointIds.GetSize (); i++) {
 			Int32 start = i;
 			Int32 end = i == pointIds.GetSize () - 1 ? 0 : i + 1;
 
-			ACAPI_Body_AddEdge (bodyData, bodyVertices[pointIds[start]], bodyVertices[pointIds[end]], bodyEdge);
+			const UInt32 startVertex = bodyVertices[pointIds[start]];
+			const UInt32 endVertex = bodyVertices[pointIds[end]];
+
+			Int32 bodyEdge = 0;
+			bodyEdges.GetEdge (startVertex, endVertex, bodyEdge);
 			polygonEdges.Push (bodyEdge);
 		}
 
-		API_OverriddenAttribute overrideMaterial;
-		ModelInfo::Material material;
-		if (NoError == modelInfo.GetMaterial (polygon.GetMaterial (), material)) {
-			API_Attribute materialAttribute;
-			err = attributeManager.GetMaterial (material, materialAttribute);
-			if (NoError == err) {
-				SetAPIOverriddenAttribute (overrideMaterial, materialAttribute.header.index);
-			}
-		}
+		API_OverriddenAttribute overrideMaterial{};
+		const Int32 materialIndex = polygon.GetMaterial ();
+		if (materialIndex >= 0 && (UInt32) materialIndex < materialOverrides.GetSize ())
+			overrideMaterial = materialOverrides[materialIndex];
 
 		ACAPI_Body_AddPolygon (bodyData, polygonEdges, 0, overrideMaterial, bodyPolygon);
 	}
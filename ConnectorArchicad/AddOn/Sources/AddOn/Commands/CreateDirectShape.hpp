@@ -12,6 +12,7 @@ class CreateDirectShape : public CreateCommand {
 	GS::UniString		GetUndoableCommandName () const override;
 
 	GSErrCode			GetElementFromObjectState (const GS::ObjectState& os,
+							DecodedObjectState& decoded,
 							API_Element& element,
 							API_Element& elementMask,
 							API_ElementMemo& memo,
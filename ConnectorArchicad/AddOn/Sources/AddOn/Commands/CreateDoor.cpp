@@ -29,6 +29,7 @@ GS::UniString CreateDoor::GetUndoableCommandName () const
 
 
 GSErrCode CreateDoor::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& /*decoded*/,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
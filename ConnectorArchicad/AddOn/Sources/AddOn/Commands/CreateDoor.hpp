@@ -10,6 +10,7 @@ namespace AddOnCommands {
 class CreateDoor : public CreateOpeningBase {
 	GS::UniString		GetUndoableCommandName () const override;
 	GSErrCode			GetElementFromObjectState (const GS::ObjectState& os,
+							DecodedObjectState& decoded,
 							API_Element& element,
 							API_Element& elementMask,
 							API_ElementMemo& memo,
@@ -25,6 +25,7 @@ GS::UniString CreateGridElement::GetUndoableCommandName () const
 
 
 GSErrCode CreateGridElement::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& /*decoded*/,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
@@ -30,6 +30,7 @@ GS::UniString CreateObject::GetUndoableCommandName () const
 
 
 GSErrCode CreateObject::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& /*decoded*/,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
@@ -130,20 +131,38 @@ GS::ObjectState CreateObject::Execute (const GS::ObjectState& parameters, GS::Pr
 	GS::Array<ModelInfo> meshModels;
 	parameters.Get (FieldNames::MeshModels, meshModels);
 
+	bool cancelled = false;
+
 	ACAPI_CallUndoableCommand (GetUndoableCommandName (), [&] () -> GSErrCode {
 		LibraryHelper helper (false);
 
 		AttributeManager* attributeManager = AttributeManager::GetInstance ();
 		LibpartImportManager* libpartImportManager = LibpartImportManager::GetInstance ();
-		for (ModelInfo meshModel : meshModels) {
+
+		StartProgress (processControl, "Speckle Library", meshModels.GetSize ());
+
+		for (UInt32 modelIndex = 0; modelIndex < meshModels.GetSize (); modelIndex++) {
+			// the library parts created so far are kept and reused by the next receive, but no object is placed
+			if (ReportProgress (processControl, modelIndex)) {
+				cancelled = true;
+				break;
+			}
+
 			API_LibPart libPart;
-			GS::ErrCode err = libpartImportManager->GetLibpart (meshModel, *attributeManager, libPart);
+			GS::ErrCode err = libpartImportManager->GetLibpart (meshModels[modelIndex], *attributeManager, libPart);
 			if (err != NoError)
 				return err;
 		}
 		return NoError;
 	});
 
+	if (cancelled) {
+		GS::ObjectState result;
+		result.Add (ApplicationObject::ApplicationObjects, GS::Array<GS::ObjectState> ());
+		result.Add (Cancelled, true);
+		return result;
+	}
+
 	return CreateCommand::Execute (parameters, processControl);
 }
 
@@ -35,6 +35,7 @@ GS::UniString CreateOpening::GetUndoableCommandName () const
 
 
 GS::ErrCode CreateOpening::GetElementFromObjectState (const GS::ObjectState& os,
+		DecodedObjectState& /*decoded*/,
 		API_Element& element,
 		API_Element& elementMask,
 		API_ElementMemo& memo,
@@ -13,6 +13,7 @@ class CreateOpening : public CreateOpeningBase {
 	GS::UniString		GetUndoableCommandName () const override;
 
 	GSErrCode			GetElementFromObjectState (const GS::ObjectState& os,
+							DecodedObjectState& decoded,
 							API_Element& element,
 							API_Element& elementMask,
 							API_ElementMemo& memo,
@@ -27,6 +27,7 @@ GS::UniString CreateRoof::GetUndoableCommandName () const
 
 
 GSErrCode CreateRoof::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& decoded,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
@@ -76,7 +77,7 @@ GSErrCode CreateRoof::GetElementFromObjectState (const GS::ObjectState& os,
 	case API_PlaneRoofID:
 
 		if (os.Contains (ElementBase::Shape)) {
-			os.Get (ElementBase::Shape, roofShape);
+			GetShapeFromObjectState (os, decoded, ElementBase::Shape, roofShape);
 			element.roof.u.planeRoof.poly.nSubPolys = roofShape.SubpolyCount ();
 			element.roof.u.planeRoof.poly.nCoords = roofShape.VertexCount ();
 			element.roof.u.planeRoof.poly.nArcs = roofShape.ArcCount ();
@@ -114,7 +115,7 @@ GSErrCode CreateRoof::GetElementFromObjectState (const GS::ObjectState& os,
 
 		// Shape (contour polygon)
 		if (os.Contains (ElementBase::Shape)) {
-			os.Get (ElementBase::Shape, roofShape);
+			GetShapeFromObjectState (os, decoded, ElementBase::Shape, roofShape);
 			element.roof.u.polyRoof.contourPolygon.nSubPolys = roofShape.SubpolyCount ();
 			element.roof.u.polyRoof.contourPolygon.nCoords = roofShape.VertexCount ();
 			element.roof.u.polyRoof.contourPolygon.nArcs = roofShape.ArcCount ();
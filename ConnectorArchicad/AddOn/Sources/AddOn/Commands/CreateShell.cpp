@@ -28,6 +28,7 @@ GS::UniString CreateShell::GetUndoableCommandName () const
 
 
 GSErrCode CreateShell::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& decoded,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
@@ -178,7 +179,7 @@ GSErrCode CreateShell::GetElementFromObjectState (const GS::ObjectState& os,
 		}
 
 		if (os.Contains (ElementBase::Shape)) {
-			os.Get (ElementBase::Shape, shellShape);
+			GetShapeFromObjectState (os, decoded, ElementBase::Shape, shellShape);
 			element.shell.u.extrudedShell.shellShape.nSubPolys = shellShape.SubpolyCount ();
 			element.shell.u.extrudedShell.shellShape.nCoords = shellShape.VertexCount ();
 			element.shell.u.extrudedShell.shellShape.nArcs = shellShape.ArcCount ();
@@ -428,7 +429,7 @@ GSErrCode CreateShell::GetElementFromObjectState (const GS::ObjectState& os,
 		}
 
 		if (os.Contains (ElementBase::Shape)) {
-			os.Get (ElementBase::Shape, shellShape);
+			GetShapeFromObjectState (os, decoded, ElementBase::Shape, shellShape);
 			element.shell.u.revolvedShell.shellShape.nSubPolys = shellShape.SubpolyCount ();
 			element.shell.u.revolvedShell.shellShape.nCoords = shellShape.VertexCount ();
 			element.shell.u.revolvedShell.shellShape.nArcs = shellShape.ArcCount ();
@@ -658,7 +659,7 @@ GSErrCode CreateShell::GetElementFromObjectState (const GS::ObjectState& os,
 	case API_RuledShellID:
 
 		if (os.Contains (ElementBase::Shape1)) {
-			os.Get (ElementBase::Shape1, shellShape1);
+			GetShapeFromObjectState (os, decoded, ElementBase::Shape1, shellShape1);
 			element.shell.u.ruledShell.shellShape1.nSubPolys = shellShape1.SubpolyCount ();
 			element.shell.u.ruledShell.shellShape1.nCoords = shellShape1.VertexCount ();
 			element.shell.u.ruledShell.shellShape1.nArcs = shellShape1.ArcCount ();
@@ -678,7 +679,7 @@ GSErrCode CreateShell::GetElementFromObjectState (const GS::ObjectState& os,
 		}
 
 		if (os.Contains (ElementBase::Shape2)) {
-			os.Get (ElementBase::Shape2, shellShape2);
+			GetShapeFromObjectState (os, decoded, ElementBase::Shape2, shellShape2);
 			element.shell.u.ruledShell.shellShape2.nSubPolys = shellShape2.SubpolyCount ();
 			element.shell.u.ruledShell.shellShape2.nCoords = shellShape2.VertexCount ();
 			element.shell.u.ruledShell.shellShape2.nArcs = shellShape2.ArcCount ();
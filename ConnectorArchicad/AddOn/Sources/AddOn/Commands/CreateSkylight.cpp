@@ -30,6 +30,7 @@ GS::UniString CreateSkylight::GetUndoableCommandName () const
 
 
 GSErrCode CreateSkylight::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& /*decoded*/,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
@@ -29,6 +29,7 @@ GS::UniString CreateSlab::GetUndoableCommandName () const
 
 
 GSErrCode CreateSlab::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& decoded,
 	API_Element& element,
 	API_Element& mask,
 	API_ElementMemo& memo,
@@ -56,7 +57,7 @@ GSErrCode CreateSlab::GetElementFromObjectState (const GS::ObjectState& os,
 	Objects::ElementShape slabShape;
 
 	if (os.Contains (ElementBase::Shape)) {
-		os.Get (ElementBase::Shape, slabShape);
+		GetShapeFromObjectState (os, decoded, ElementBase::Shape, slabShape);
 		element.slab.poly.nSubPolys = slabShape.SubpolyCount ();
 		element.slab.poly.nCoords = slabShape.VertexCount ();
 		element.slab.poly.nArcs = slabShape.ArcCount ();
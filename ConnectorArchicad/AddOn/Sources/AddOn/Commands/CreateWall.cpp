@@ -31,6 +31,7 @@ GS::UniString CreateWall::GetUndoableCommandName () const
 
 
 GSErrCode CreateWall::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& decoded,
 	API_Element& element,
 	API_Element& elementMask,
 	API_ElementMemo& memo,
@@ -190,7 +191,7 @@ GSErrCode CreateWall::GetElementFromObjectState (const GS::ObjectState& os,
 	Objects::ElementShape wallShape;
 
 	if (os.Contains (ElementBase::Shape)) {
-		os.Get (ElementBase::Shape, wallShape);
+		GetShapeFromObjectState (os, decoded, ElementBase::Shape, wallShape);
 		element.wall.poly.nSubPolys = wallShape.SubpolyCount ();
 		element.wall.poly.nCoords = wallShape.VertexCount ();
 		element.wall.poly.nArcs = wallShape.ArcCount ();
@@ -27,6 +27,7 @@ GS::UniString CreateZone::GetUndoableCommandName () const
 
 
 GSErrCode CreateZone::GetElementFromObjectState (const GS::ObjectState& os,
+	DecodedObjectState& decoded,
 	API_Element& element,
 	API_Element& mask,
 	API_ElementMemo& memo,
@@ -53,7 +54,7 @@ GSErrCode CreateZone::GetElementFromObjectState (const GS::ObjectState& os,
 	Objects::ElementShape zoneShape;
 
 	if (os.Contains (ElementBase::Shape)) {
-		os.Get (ElementBase::Shape, zoneShape);
+		GetShapeFromObjectState (os, decoded, ElementBase::Shape, zoneShape);
 		element.zone.poly.nSubPolys = zoneShape.SubpolyCount ();
 		element.zone.poly.nCoords = zoneShape.VertexCount ();
 		element.zone.poly.nArcs = zoneShape.ArcCount ();
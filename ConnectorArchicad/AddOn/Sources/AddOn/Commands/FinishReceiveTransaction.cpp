@@ -1,6 +1,6 @@
 #include "FinishReceiveTransaction.hpp"
-#include "LibpartImportManager.hpp"
 #include "ClassificationImportManager.hpp"
+#include "LibpartImportManager.hpp"
 #include "PropertyExportManager.hpp"
 #include "ResourceIds.hpp"
 
@@ -9,8 +9,8 @@ GS::ObjectState AddOnCommands::FinishReceiveTransaction::Execute (const GS::Obje
 {
 	AttributeManager::DeleteInstance();
     LibpartImportManager::DeleteInstance ();
-	ClassificationImportManager::DeleteInstance ();
     PropertyExportManager::DeleteInstance ();
+    ClassificationImportManager::GetInstance ()->ForgetMissingItems ();
     return GS::ObjectState ();
 }
 
@@ -41,11 +41,12 @@ GS::UInt64 GetBeamData::GetMemoMask () const
 
 GS::ErrCode GetBeamData::SerializeElementType (const API_Element& elem,
 	const API_ElementMemo& memo,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	// Positioning
 	API_StoryType story = Utility::GetStory (elem.beam.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	double z = Utility::GetStoryLevel (elem.beam.head.floorInd) + elem.beam.level;
 	os.Add (Beam::begC, Objects::Point3D (elem.beam.begC.x, elem.beam.begC.y, z));
@@ -0,0 +1,60 @@
+#include "GetChangesSince.hpp"
+#include "ResourceIds.hpp"
+#include "ObjectState.hpp"
+#include "FieldNames.hpp"
+#include "ChangeJournal.hpp"
+using namespace FieldNames;
+
+
+namespace AddOnCommands {
+
+
+GS::String GetChangesSince::GetName () const
+{
+	return GetChangesSinceCommandName;
+}
+
+
+GS::ObjectState GetChangesSince::Execute (const GS::ObjectState& parameters, GS::ProcessControl& /*processControl*/) const
+{
+	GS::UniString journalId;
+	GS::UInt64 sequence = 0;
+	parameters.Get (Changes::JournalId, journalId);
+	parameters.Get (Changes::Sequence, sequence);
+
+	ChangeJournal* journal = ChangeJournal::GetInstance ();
+	if (!journal->IsStarted ()) {
+		// the first caller starts the journal, it has no changes to tell yet, so the caller gets an overflow below
+		journal->Start ();
+	}
+
+	GS::ObjectState result;
+	result.Add (Changes::JournalId, APIGuidToString (journal->GetJournalId ()));
+	result.Add (Changes::Sequence, journal->GetLastSequence ());
+
+	GS::HashTable<API_Guid, ChangeJournal::ChangeType> changes;
+	if (journalId.IsEmpty () || !journal->GetChangesSince (APIGuidFromString (journalId.ToCStr ()), sequence, changes)) {
+		// the changes are not known since the given sequence, the caller sends everything and continues from the returned sequence
+		result.Add (Changes::Overflow, true);
+		return result;
+	}
+
+	const auto& createdAdder = result.AddList<GS::UniString> (Changes::Created);
+	const auto& modifiedAdder = result.AddList<GS::UniString> (Changes::Modified);
+	const auto& deletedAdder = result.AddList<GS::UniString> (Changes::Deleted);
+	for (const auto& change : changes) {
+		const GS::UniString applicationId = APIGuidToString (*change.key);
+		switch (*change.value) {
+			case ChangeJournal::Created:	createdAdder (applicationId); break;
+			case ChangeJournal::Modified:	modifiedAdder (applicationId); break;
+			case ChangeJournal::Deleted:	deletedAdder (applicationId); break;
+		}
+	}
+
+	result.Add (Changes::Overflow, false);
+
+	return result;
+}
+
+
+}
@@ -0,0 +1,20 @@
+#ifndef GET_CHANGES_SINCE_HPP
+#define GET_CHANGES_SINCE_HPP
+
+#include "BaseCommand.hpp"
+
+
+namespace AddOnCommands {
+
+
+class GetChangesSince : public BaseCommand {
+public:
+	virtual GS::String		GetName () const override;
+	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override;
+};
+
+
+}
+
+
+#endif
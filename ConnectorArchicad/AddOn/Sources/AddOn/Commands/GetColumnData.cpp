@@ -37,11 +37,12 @@ GS::UInt64 GetColumnData::GetMemoMask () const
 
 GS::ErrCode	GetColumnData::SerializeElementType (const API_Element& elem,
 	const API_ElementMemo& memo,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	// Positioning - geometry
 	API_StoryType story = Utility::GetStory (elem.column.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	double z = Utility::GetStoryLevel (elem.column.head.floorInd) + elem.column.bottomOffset;
 	os.Add (Column::origoPos, Objects::Point3D (elem.column.origoPos.x, elem.column.origoPos.y, z));
@@ -13,6 +13,7 @@ class GetColumnData : public GetDataCommand {
 	GS::UInt64			GetMemoMask () const override;
 	GS::ErrCode			SerializeElementType (const API_Element& elem,
 							const API_ElementMemo& memo,
+							ResponseDictionary* dictionary,
 							GS::ObjectState& os) const override;
 
 public:
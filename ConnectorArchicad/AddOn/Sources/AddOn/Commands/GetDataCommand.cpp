@@ -3,6 +3,8 @@
 #include "FieldNames.hpp"
 #include "Utility.hpp"
 #include "PropertyExportManager.hpp"
+#include "PerformanceStats.hpp"
+#include "Objects/Level.hpp"
 
 #include "BM.hpp"
 
@@ -245,6 +247,8 @@ namespace {
 		API_QuantityPar quantityParameters{};
 		quantityParameters.minOpeningSize = Eps;
 		MaterialQuantArray result;
+		static PerformanceStats::Counter& quantityCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::QuantityApi);
+		PerformanceStats::ScopedTimer timer (quantityCounter);
 		return ACAPI_Element_GetQuantities(element.header.guid, &quantityParameters, &extendedQuantity, &quantityMask);
 	} //measureQuantities
 	
@@ -344,7 +348,12 @@ namespace {
 		API_Attribute attribute{};
 		attribute.header.index = materialIndex;
 		attribute.header.typeID = API_BuildingMaterialID;
-		auto error = ACAPI_Attribute_Get(&attribute);
+		GS::ErrCode error = NoError;
+		{
+			static PerformanceStats::Counter& attributeCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::AttributeApi);
+			PerformanceStats::ScopedTimer timer (attributeCounter);
+			error = ACAPI_Attribute_Get(&attribute);
+		}
 		if (error != NoError)
 			return error;
 		serialiser.Add(FieldNames::Material::Name, GS::UniString{attribute.header.name});
@@ -356,10 +365,11 @@ namespace {
 	 Serialise the material quantities of a specified element for export
 	 @param element The target element
 	 @param memo The memo data attached to the element
+	 @param dictionary The tables of the response, nullptr to serialise the materials themselves
 	 @param serialiser A serialiser for the exported data
 	 @return NoError if the export serialisation completed without errors
 	 */
-	GS::ErrCode exportMaterialQuantities(const API_Element& element, const API_ElementMemo& memo, GS::ObjectState& serialiser) {
+	GS::ErrCode exportMaterialQuantities(const API_Element& element, const API_ElementMemo& memo, ResponseDictionary* dictionary, GS::ObjectState& serialiser) {
 		auto materialQuants = getQuantity(element, memo);
 		if (materialQuants.empty())
 			return NoError;
@@ -369,7 +379,13 @@ namespace {
 			auto error = exportMaterial(quantity.materialIndex, serialMaterial);
 			if (error != NoError)
 				return error;
-			serialMaterialQuant.Add(FieldNames::ElementBase::Quantity::Material, serialMaterial);
+			if (dictionary != nullptr) {
+				GS::UniString materialName;
+				serialMaterial.Get(FieldNames::Material::Name, materialName);
+				serialMaterialQuant.Add(FieldNames::Dictionaries::MaterialIndex, dictionary->AddMaterial(materialName));
+			} else {
+				serialMaterialQuant.Add(FieldNames::ElementBase::Quantity::Material, serialMaterial);
+			}
 			serialMaterialQuant.Add(FieldNames::ElementBase::Quantity::Volume, quantity.volume);
 			serialMaterialQuant.Add(FieldNames::ElementBase::Quantity::Area, quantity.surfaceArea);
 			serialMaterialQuant.Add(FieldNames::ElementBase::Quantity::Units, GS::UniString{"m"});
@@ -385,151 +401,163 @@ namespace AddOnCommands
 {
 
 
-GS::ErrCode SerializePropertyGroups (const GS::Array<API_PropertyDefinition>& definitions, const GS::Array<API_Property>& properties, std::function<void (const GS::ObjectState&)> propertyGroupListAdder)
+// the index of a name is added under its own field, so the connector doesn't have to tell it from a number value
+static void AddName (GS::ObjectState& os, const char* fieldName, const char* indexFieldName, const GS::UniString& name, UInt32 (ResponseDictionary::*addToTable) (const GS::UniString&), ResponseDictionary* dictionary)
 {
-	GS::ErrCode err = NoError;
+	if (dictionary != nullptr)
+		os.Add (indexFieldName, (dictionary->*addToTable) (name));
+	else
+		os.Add (fieldName, name);
+}
 
-	GS::HashTable<API_Guid, GS::Pair<GS::UniString, GS::Array<API_PropertyDefinition>>> propertiesByGroup;
 
-	for (UInt32 i = 0; i < definitions.GetSize (); i++) {
-		API_PropertyDefinition definition = definitions[i];
+static bool SerializeProperty (const API_Property& apiProperty, ResponseDictionary* dictionary, const std::function<void (const GS::ObjectState&)>& propertyListAdder)
+{
+	if (apiProperty.status != API_Property_HasValue || apiProperty.value.variantStatus != API_VariantStatusNormal)
+		return false;
+
+	switch (apiProperty.definition.collectionType) {
+		case API_PropertySingleCollectionType:
+		case API_PropertySingleChoiceEnumerationCollectionType:
+		{
+			GS::ObjectState propertyOs;
+			AddName (propertyOs, FieldNames::ElementBase::Property::Name, FieldNames::Dictionaries::NameIndex, apiProperty.definition.name, &ResponseDictionary::AddPropertyName, dictionary);
+
+			switch (apiProperty.value.singleVariant.variant.type) {
+			case API_PropertyIntegerValueType:
+				propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.intValue);
+				break;
+			case API_PropertyRealValueType:
+				if (GS::ClassifyDouble (apiProperty.value.singleVariant.variant.doubleValue) == GS::DoubleClass::Normal)
+					propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.doubleValue);
+				break;
+			case API_PropertyStringValueType:
+				propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.uniStringValue);
+				break;
+			case API_PropertyBooleanValueType:
+				propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.boolValue);
+				break;
+			case API_PropertyGuidValueType:
+				for (auto& possibleEnumValue : apiProperty.definition.possibleEnumValues) {
+					if (possibleEnumValue.keyVariant.guidValue == apiProperty.value.singleVariant.variant.guidValue) {
+						propertyOs.Add (FieldNames::ElementBase::Property::Value, possibleEnumValue.displayVariant.uniStringValue);
+						break;
+					}
+				}
+				break;
+			default:
+				return false;
+			}
 
-		API_PropertyGroup group;
-		group.guid = definition.groupGuid;
-		err = ACAPI_Property_GetPropertyGroup (group);
-		if (err != NoError)
-			continue;
+			propertyListAdder (propertyOs);
+			return true;
+		}
+		case API_PropertyListCollectionType:
+		case API_PropertyMultipleChoiceEnumerationCollectionType:
+		{
+			if (apiProperty.value.listVariant.variants.GetSize () == 0)
+				return false;
 
-		const GS::UniString& groupName = group.name;
-		const API_Guid& groupID = group.guid;
+			GS::ObjectState propertyOs;
+			AddName (propertyOs, FieldNames::ElementBase::Property::Name, FieldNames::Dictionaries::NameIndex, apiProperty.definition.name, &ResponseDictionary::AddPropertyName, dictionary);
 
-		if (propertiesByGroup.ContainsKey (groupID)) {
-			propertiesByGroup[groupID].second.Push (definition);
-		} else {
-			GS::Array<API_PropertyDefinition> definitionsByGroup;
-			definitionsByGroup.Push (definition);
-			propertiesByGroup.Add (groupID, GS::Pair<GS::UniString, GS::Array<API_PropertyDefinition>> (groupName, definitionsByGroup));
+			switch (apiProperty.value.listVariant.variants[0].type) {
+			case API_PropertyIntegerValueType:
+			{
+				const auto& valueListAdder = propertyOs.AddList<int> (FieldNames::ElementBase::Property::Values);
+				for (auto value : apiProperty.value.listVariant.variants) {
+					valueListAdder (value.intValue);
+				}
+				break;
+			}
+			case API_PropertyRealValueType:
+			{
+				const auto& valueListAdder = propertyOs.AddList<double> (FieldNames::ElementBase::Property::Values);
+				for (auto value : apiProperty.value.listVariant.variants) {
+					if (GS::ClassifyDouble (value.doubleValue) == GS::DoubleClass::Normal)
+						valueListAdder (value.doubleValue);
+				}
+				break;
+			}
+			case API_PropertyStringValueType:
+			{
+				const auto& valueListAdder = propertyOs.AddList<GS::UniString> (FieldNames::ElementBase::Property::Values);
+				for (auto value : apiProperty.value.listVariant.variants) {
+					valueListAdder (value.uniStringValue);
+				}
+				break;
+			}
+			case API_PropertyBooleanValueType:
+			{
+				const auto& valueListAdder = propertyOs.AddList<bool> (FieldNames::ElementBase::Property::Values);
+				for (auto value : apiProperty.value.listVariant.variants) {
+					valueListAdder (value.boolValue);
+				}
+				break;
+			}
+			case API_PropertyGuidValueType:
+			{
+				const auto& valueListAdder = propertyOs.AddList<GS::UniString> (FieldNames::ElementBase::Property::Values);
+				for (auto& possibleEnumValue : apiProperty.definition.possibleEnumValues) {
+					for (auto value : apiProperty.value.listVariant.variants) {
+						if (possibleEnumValue.keyVariant.guidValue == value.guidValue) {
+							valueListAdder (possibleEnumValue.displayVariant.uniStringValue);
+							break;
+						}
+					}
+				}
+				break;
+			}
+			default:
+				return false;
+			}
+
+			propertyListAdder (propertyOs);
+			return true;
 		}
+		case API_PropertyUndefinedCollectionType:
+			return false;
 	}
 
-	for (auto& propertyByGroup : propertiesByGroup) {
-		const API_Guid& groupID = *propertyByGroup.key;
+	return false;
+}
 
-		GS::ObjectState propertyGroupsOs;
-		propertyGroupsOs.Add (FieldNames::ElementBase::PropertyGroup::Name, propertyByGroup.value->first);
-		const auto& propertyListAdder = propertyGroupsOs.AddList<GS::ObjectState> (FieldNames::ElementBase::PropertyGroup::PropertList);
 
-		bool propertyAdded = false;
-		for (auto& apiProperty : properties) {
-			if (apiProperty.definition.groupGuid != groupID)
-				continue;
-			
-			if (apiProperty.status == API_Property_HasValue && apiProperty.value.variantStatus == API_VariantStatusNormal) {
-				switch (apiProperty.definition.collectionType) {
-					case API_PropertySingleCollectionType:
-					case API_PropertySingleChoiceEnumerationCollectionType:
-					{
-						GS::ObjectState propertyOs;
-						propertyOs.Add (FieldNames::ElementBase::Property::Name, apiProperty.definition.name);
-
-						switch (apiProperty.value.singleVariant.variant.type) {
-						case API_PropertyIntegerValueType:
-							propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.intValue);
-							break;
-						case API_PropertyRealValueType:
-							if (GS::ClassifyDouble (apiProperty.value.singleVariant.variant.doubleValue) == GS::DoubleClass::Normal)
-								propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.doubleValue);
-							break;
-						case API_PropertyStringValueType:
-							propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.uniStringValue);
-							break;
-						case API_PropertyBooleanValueType:
-							propertyOs.Add (FieldNames::ElementBase::Property::Value, apiProperty.value.singleVariant.variant.boolValue);
-							break;
-						case API_PropertyGuidValueType:
-							for (auto& possibleEnumValue : apiProperty.definition.possibleEnumValues) {
-								if (possibleEnumValue.keyVariant.guidValue == apiProperty.value.singleVariant.variant.guidValue) {
-									propertyOs.Add (FieldNames::ElementBase::Property::Value, possibleEnumValue.displayVariant.uniStringValue);
-									break;
-								}
-							}
-							break;
-						default:
-							continue;
-						}
+/*!
+ Serialise property values in their groups
+ The groups come from the layout cached for the definition set, so only the values are handled for each element
+ @param definitions The definitions the values were retrieved with
+ @param properties The property values
+ @param dictionary The response dictionary for the group and property names, nullptr to write the names
+ @param propertyGroupListAdder Adds a serialised group to the response
+ @return NoError if the serialisation was successful
+ */
+GS::ErrCode SerializePropertyGroups (const GS::Array<API_PropertyDefinition>& definitions, const GS::Array<API_Property>& properties, ResponseDictionary* dictionary, std::function<void (const GS::ObjectState&)> propertyGroupListAdder)
+{
+	const PropertyExportManager::PropertyGroupLayout& layout = PropertyExportManager::GetInstance ()->GetGroupLayout (definitions);
 
-						propertyListAdder (propertyOs);
-						propertyAdded = true;
-						break;
-					}
-					case API_PropertyListCollectionType:
-					case API_PropertyMultipleChoiceEnumerationCollectionType:
-					{
-						if (apiProperty.value.listVariant.variants.GetSize () == 0)
-							continue;
-
-						GS::ObjectState propertyOs;
-						propertyOs.Add (FieldNames::ElementBase::Property::Name, apiProperty.definition.name);
-
-						switch (apiProperty.value.listVariant.variants[0].type) {
-						case API_PropertyIntegerValueType:
-						{
-							const auto& valueListAdder = propertyOs.AddList<int> (FieldNames::ElementBase::Property::Values);
-							for (auto value : apiProperty.value.listVariant.variants) {
-								valueListAdder (value.intValue);
-							}
-							break;
-						}
-						case API_PropertyRealValueType:
-						{
-							const auto& valueListAdder = propertyOs.AddList<double> (FieldNames::ElementBase::Property::Values);
-							for (auto value : apiProperty.value.listVariant.variants) {
-								if (GS::ClassifyDouble (value.doubleValue) == GS::DoubleClass::Normal)
-									valueListAdder (value.doubleValue);
-							}
-							break;
-						}
-						case API_PropertyStringValueType:
-						{
-							const auto& valueListAdder = propertyOs.AddList<GS::UniString> (FieldNames::ElementBase::Property::Values);
-							for (auto value : apiProperty.value.listVariant.variants) {
-								valueListAdder (value.uniStringValue);
-							}
-							break;
-						}
-						case API_PropertyBooleanValueType:
-						{
-							const auto& valueListAdder = propertyOs.AddList<bool> (FieldNames::ElementBase::Property::Values);
-							for (auto value : apiProperty.value.listVariant.variants) {
-								valueListAdder (value.boolValue);
-							}
-							break;
-						}
-						case API_PropertyGuidValueType:
-						{
-							const auto& valueListAdder = propertyOs.AddList<GS::UniString> (FieldNames::ElementBase::Property::Values);
-							for (auto& possibleEnumValue : apiProperty.definition.possibleEnumValues) {
-								for (auto value : apiProperty.value.listVariant.variants) {
-									if (possibleEnumValue.keyVariant.guidValue == value.guidValue) {
-										valueListAdder (possibleEnumValue.displayVariant.uniStringValue);
-										break;
-									}
-								}
-							}
-							break;
-						}
-						default:
-							continue;
-						}
+	GS::Array<GS::Array<const API_Property*>> propertiesByGroup;
+	for (UInt32 i = 0; i < layout.groups.GetSize (); i++)
+		propertiesByGroup.Push (GS::Array<const API_Property*> ());
 
-						propertyListAdder (propertyOs);
-						propertyAdded = true;
-						break;
-					}
-					case API_PropertyUndefinedCollectionType:
-						continue;
-				}
-			}
+	for (const auto& apiProperty : properties) {
+		UInt32 groupIndex = 0;
+		if (layout.groupIndices.Get (apiProperty.definition.groupGuid, &groupIndex))
+			propertiesByGroup[groupIndex].Push (&apiProperty);
+	}
+
+	for (UInt32 groupIndex = 0; groupIndex < layout.groups.GetSize (); groupIndex++) {
+		if (propertiesByGroup[groupIndex].IsEmpty ())
+			continue;
+
+		GS::ObjectState propertyGroupsOs;
+		AddName (propertyGroupsOs, FieldNames::ElementBase::PropertyGroup::Name, FieldNames::Dictionaries::NameIndex, layout.groups[groupIndex].second, &ResponseDictionary::AddPropertyGroup, dictionary);
+		std::function<void (const GS::ObjectState&)> propertyListAdder = propertyGroupsOs.AddList<GS::ObjectState> (FieldNames::ElementBase::PropertyGroup::PropertList);
+
+		bool propertyAdded = false;
+		for (const API_Property* apiProperty : propertiesByGroup[groupIndex]) {
+			if (SerializeProperty (*apiProperty, dictionary, propertyListAdder))
+				propertyAdded = true;
 		}
 
 		if (propertyAdded)
@@ -543,31 +571,39 @@ GS::ErrCode SerializePropertyGroups (const GS::Array<API_PropertyDefinition>& de
 /*!
  Export attached Archicad properties, listing properties (calculated) and material quantities from a specified element
  @param element The target element to export the properties from
+ @param memo Memo data of the element, the beam and column segments are used to share the component definitions between elements of the same structure
  @param sendProperties True to export the Archicad properties attached to the element
  @param sendListingParameters True to export calculated listing parameters from the element, e.g. top/bottom surface area etc
  @param systemItemPairs Array pairing a classification system ID against a classification item ID (attached to the target element)
+ @param dictionary The tables of the response, nullptr to serialise the property names themselves
  @param os A collector/serialiser for the exported data
  @return NoError if the export was successful
  */
-GS::ErrCode GetDataCommand::ExportProperties (const API_Element& element, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, GS::ObjectState& os) const
+GS::ErrCode GetDataCommand::ExportProperties (const API_Element& element, const API_ElementMemo& memo, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, ResponseDictionary* dictionary, GS::ObjectState& os) const
 {
 	if (!sendProperties && !sendListingParameters)
 		return NoError;
 
-	GS::Array<API_PropertyDefinition> elementDefinitions;
-	GS::Array < GS::Pair<API_ElemComponentID, GS::Array<API_PropertyDefinition>>> componentsDefinitions;
+	static PerformanceStats::Counter& propertyCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::PropertyApi);
 
-	GS::ErrCode err = PropertyExportManager::GetInstance ()->GetElementDefinitions (element, sendProperties, sendListingParameters, systemItemPairs, elementDefinitions, componentsDefinitions);
+	const GS::Array<API_PropertyDefinition>* elementDefinitions = nullptr;
+	GS::Array<API_ElemComponentID> components;
+	const GS::Array<GS::Array<API_PropertyDefinition>>* componentsDefinitions = nullptr;
+
+	GS::ErrCode err = PropertyExportManager::GetInstance ()->GetElementDefinitions (element, memo, sendProperties, sendListingParameters, systemItemPairs, elementDefinitions, components, componentsDefinitions);
 	if (err != NoError)
 		return err;
 
 	// element properties
 	{
 		GS::Array<API_Property> properties;
-		err = ACAPI_Element_GetPropertyValues (element.header.guid, elementDefinitions, properties);
+		{
+			PerformanceStats::ScopedTimer timer (propertyCounter);
+			err = ACAPI_Element_GetPropertyValues (element.header.guid, *elementDefinitions, properties);
+		}
 		if (err == NoError && !properties.IsEmpty ()) {
 			const auto& propertyGroupListAdder = os.AddList<GS::ObjectState> (FieldNames::ElementBase::ElementProperties);
-			err = SerializePropertyGroups (elementDefinitions, properties, propertyGroupListAdder);
+			err = SerializePropertyGroups (*elementDefinitions, properties, dictionary, propertyGroupListAdder);
 			if (err != NoError)
 				return err;
 		}
@@ -577,13 +613,20 @@ GS::ErrCode GetDataCommand::ExportProperties (const API_Element& element, const
 	auto componentPropertyListAdder = os.AddList<GS::ObjectState> (FieldNames::ElementBase::ComponentProperties);
 
 	UInt32 componentNumber (1);
-	for (auto& componentDefinitions : componentsDefinitions) {
+	for (UInt32 componentIndex = 0; componentIndex < components.GetSize (); componentIndex++) {
+		const GS::Array<API_PropertyDefinition>& componentDefinitions = (*componentsDefinitions)[componentIndex];
+		if (componentDefinitions.IsEmpty ())
+			continue;
+
 		GS::Array<API_Property> properties;
+		{
+			PerformanceStats::ScopedTimer timer (propertyCounter);
 #ifdef ServerMainVers_2700
-		err = ACAPI_Element_GetPropertyValues (componentDefinitions.first, componentDefinitions.second, properties);
+			err = ACAPI_Element_GetPropertyValues (components[componentIndex], componentDefinitions, properties);
 #else
-		err = ACAPI_ElemComponent_GetPropertyValues (componentDefinitions.first, componentDefinitions.second, properties);
+			err = ACAPI_ElemComponent_GetPropertyValues (components[componentIndex], componentDefinitions, properties);
 #endif
+		}
 		if (err != NoError || properties.IsEmpty ())
 			continue;
 
@@ -591,7 +634,7 @@ GS::ErrCode GetDataCommand::ExportProperties (const API_Element& element, const
 		componentPropertiesOs.Add (FieldNames::ElementBase::ComponentProperty::Name, GS::String::SPrintf ("Component %d", componentNumber++));
 		std::function<void (const GS::ObjectState&)> propertyGroupListAdder = componentPropertiesOs.AddList<GS::ObjectState> (FieldNames::ElementBase::ComponentProperty::PropertyGroups);
 		
-		err = SerializePropertyGroups (componentDefinitions.second, properties, propertyGroupListAdder);
+		err = SerializePropertyGroups (componentDefinitions, properties, dictionary, propertyGroupListAdder);
 		if (err != NoError)
 			continue;
 
@@ -602,7 +645,7 @@ GS::ErrCode GetDataCommand::ExportProperties (const API_Element& element, const
 }
 
 
-GS::ErrCode GetDataCommand::ExportClassificationsAndProperties (const API_Element& element, GS::ObjectState& os, const bool& sendProperties, const bool& sendListingParameters) const
+GS::ErrCode GetDataCommand::ExportClassificationsAndProperties (const API_Element& element, const API_ElementMemo& memo, ResponseDictionary* dictionary, GS::ObjectState& os, const bool& sendProperties, const bool& sendListingParameters) const
 {
 	GS::ErrCode err = NoError;
 
@@ -615,8 +658,13 @@ GS::ErrCode GetDataCommand::ExportClassificationsAndProperties (const API_Elemen
 		os.Add(FieldNames::ElementBase::ElementType, typeName);
 	}
 	
+	static PerformanceStats::Counter& classificationCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::ClassificationApi);
+
 	GS::Array<GS::Pair<API_Guid, API_Guid>> systemItemPairs;
-	err = ACAPI_Element_GetClassificationItems (element.header.guid, systemItemPairs);
+	{
+		PerformanceStats::ScopedTimer timer (classificationCounter);
+		err = ACAPI_Element_GetClassificationItems (element.header.guid, systemItemPairs);
+	}
 	if (err != NoError)
 		return err;
 
@@ -626,18 +674,19 @@ GS::ErrCode GetDataCommand::ExportClassificationsAndProperties (const API_Elemen
 			GS::ObjectState classificationOs;
 			API_ClassificationSystem system;
 			system.guid = systemItemPair.first;
-			err = ACAPI_Classification_GetClassificationSystem (system);
-			if (err != NoError)
-				break;
-
-			classificationOs.Add (FieldNames::ElementBase::Classification::System, system.name);
-
 			API_ClassificationItem item;
 			item.guid = systemItemPair.second;
-			err = ACAPI_Classification_GetClassificationItem (item);
+			{
+				PerformanceStats::ScopedTimer timer (classificationCounter);
+				err = ACAPI_Classification_GetClassificationSystem (system);
+				if (err == NoError)
+					err = ACAPI_Classification_GetClassificationItem (item);
+			}
 			if (err != NoError)
 				break;
 
+			classificationOs.Add (FieldNames::ElementBase::Classification::System, system.name);
+
 			if (!item.id.IsEmpty ())
 				classificationOs.Add (FieldNames::ElementBase::Classification::Code, item.id);
 
@@ -648,7 +697,16 @@ GS::ErrCode GetDataCommand::ExportClassificationsAndProperties (const API_Elemen
 		}
 	}
 
-	return ExportProperties (element, sendProperties, sendListingParameters, systemItemPairs, os);
+	return ExportProperties (element, memo, sendProperties, sendListingParameters, systemItemPairs, dictionary, os);
+}
+
+
+void GetDataCommand::AddLevel (GS::ObjectState& os, const API_StoryType& story, ResponseDictionary* dictionary)
+{
+	if (dictionary != nullptr)
+		os.Add (FieldNames::Dictionaries::LevelIndex, dictionary->AddLevel (story));
+	else
+		os.Add (FieldNames::ElementBase::Level, Objects::Level (story));
 }
 
 
@@ -663,13 +721,14 @@ GS::UInt64 GetDataCommand::GetMemoMask () const
  
  elem: The target element
  memo: Memo data attached to the element
+ dictionary: The tables of the response, nullptr to serialise the repeated values themselves
  os: A collector/serialiser for the exported data
  sendProperties: True to export the Archicad properties attached to the element
  sendListingParameters: True to export calculated listing parameters from the element, e.g. top/bottom surface area etc
  
  return: NoError if the serialisation was successful
  */
-GS::ErrCode GetDataCommand::SerializeElementType(const API_Element& elem, const API_ElementMemo& memo, GS::ObjectState& os, const bool& sendProperties, const bool& sendListingParameters) const
+GS::ErrCode GetDataCommand::SerializeElementType(const API_Element& elem, const API_ElementMemo& memo, ResponseDictionary* dictionary, GS::ObjectState& os, const bool& sendProperties, const bool& sendListingParameters) const
 {
 	os.Add(FieldNames::ElementBase::ApplicationId, APIGuidToString (elem.header.guid));
 
@@ -678,17 +737,40 @@ GS::ErrCode GetDataCommand::SerializeElementType(const API_Element& elem, const
 	attribute.header.typeID = API_LayerID;
 	attribute.header.index = elem.header.layer;
 	if (ACAPI_Attribute_Get (&attribute) == NoError) {
-		os.Add(FieldNames::ElementBase::Layer, GS::UniString{attribute.header.name});
+		AddName (os, FieldNames::ElementBase::Layer, FieldNames::Dictionaries::LayerIndex, GS::UniString{attribute.header.name}, &ResponseDictionary::AddLayer, dictionary);
 	}
-	auto err = exportMaterialQuantities (elem, memo, os);
+	auto err = exportMaterialQuantities (elem, memo, dictionary, os);
 	if (err != NoError)
 		return err;
-	return ExportClassificationsAndProperties (elem, os, sendProperties, sendListingParameters);
+	return ExportClassificationsAndProperties (elem, memo, dictionary, os, sendProperties, sendListingParameters);
+}
+
+
+/*!
+ Serialise an element of the type of this command, with its properties
+ @param element The target element
+ @param memo Memo data of the element, as requested by GetMemoMask
+ @param sendProperties True to export the Archicad properties attached to the element
+ @param sendListingParameters True to export calculated listing parameters from the element
+ @param dictionary The tables of the response, nullptr to serialise the repeated values themselves
+ @param os A collector/serialiser for the exported data
+ @return NoError if the serialisation was successful
+ */
+GS::ErrCode GetDataCommand::SerializeElement (const API_Element& element, const API_ElementMemo& memo, bool sendProperties, bool sendListingParameters, ResponseDictionary* dictionary, GS::ObjectState& os) const
+{
+	static PerformanceStats::Counter& serializeCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::SerializeElementType);
+	PerformanceStats::ScopedTimer timer (serializeCounter);
+
+	GS::ErrCode err = SerializeElementType (element, memo, dictionary, os, sendProperties, sendListingParameters);
+	if (err == NoError)
+		err = SerializeElementType (element, memo, dictionary, os);
+
+	return err;
 }
 
 
 GS::ObjectState GetDataCommand::Execute (const GS::ObjectState& parameters,
-	GS::ProcessControl& /*processControl*/) const
+	GS::ProcessControl& processControl) const
 {
 	GS::Array<GS::UniString> ids;
 	parameters.Get (FieldNames::ElementBase::ApplicationIds, ids);
@@ -701,15 +783,38 @@ GS::ObjectState GetDataCommand::Execute (const GS::ObjectState& parameters,
 	parameters.Get (FieldNames::ElementBase::SendProperties, sendProperties);
 	parameters.Get (FieldNames::ElementBase::SendListingParameters, sendListingParameters);
 
+	bool useDictionaries = false;
+	parameters.Get (FieldNames::Dictionaries::UseDictionaries, useDictionaries);
+
+	ResponseDictionary dictionary;
+
+	// the property definitions are cached for the elements of this call only
+	PropertyExportManager::GetInstance ()->Invalidate ();
+
 	GS::ObjectState result;
 	const auto& listAdder = result.AddList<GS::ObjectState> (GetFieldName ());
-	for (const API_Guid& guid : elementGuids) {
+
+	StartProgress (processControl, GetFieldName (), elementGuids.GetSize ());
+
+	static PerformanceStats::Counter& elementGetCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::ElementGetApi);
+
+	for (UInt32 elementIndex = 0; elementIndex < elementGuids.GetSize (); elementIndex++) {
+		if (ReportProgress (processControl, elementIndex)) {
+			result.Add (FieldNames::Cancelled, true);
+			break;
+		}
+
+		const API_Guid& guid = elementGuids[elementIndex];
 		API_Element element{};
 		API_ElementMemo memo{};
 
 		element.header.guid = guid;
 
-		GSErrCode err = ACAPI_Element_Get (&element);
+		GSErrCode err = NoError;
+		{
+			PerformanceStats::ScopedTimer timer (elementGetCounter);
+			err = ACAPI_Element_Get (&element);
+		}
 		if (err != NoError)
 			continue;
 
@@ -721,23 +826,25 @@ GS::ObjectState GetDataCommand::Execute (const GS::ObjectState& parameters,
 			}
 		}
 
-		err = ACAPI_Element_GetMemo (guid, &memo, GetMemoMask ());
+		{
+			PerformanceStats::ScopedTimer timer (elementGetCounter);
+			err = ACAPI_Element_GetMemo (guid, &memo, GetMemoMask ());
+		}
 		if (err != NoError)
 			continue;
 
 		GS::ObjectState os;
-		err = SerializeElementType (element, memo, os, sendProperties, sendListingParameters);
-		if (err != NoError)
-			continue;
-		
-		err = SerializeElementType (element, memo, os);
+		err = SerializeElement (element, memo, sendProperties, sendListingParameters, useDictionaries ? &dictionary : nullptr, os);
 		if (err != NoError)
 			continue;
 		
 		listAdder (os);
 	}
 
-	return result;
+	if (useDictionaries)
+		dictionary.Store (result);
+
+	return EncodeResponse (parameters, result);
 }
 
 
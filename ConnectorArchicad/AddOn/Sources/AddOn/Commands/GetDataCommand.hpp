@@ -2,6 +2,7 @@
 #define GET_DATA_COMMAND_HPP
 
 #include "BaseCommand.hpp"
+#include "ResponseDictionary.hpp"
 
 
 namespace AddOnCommands {
@@ -11,21 +12,31 @@ class GetDataCommand : public BaseCommand {
 	virtual GS::String		GetFieldName () const = 0;
 	virtual API_ElemTypeID	GetElemTypeID () const = 0;
 	virtual GS::UInt64		GetMemoMask () const;
-	
+
 protected:
-	GS::ErrCode				ExportProperties (const API_Element& element, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, GS::ObjectState& os) const;
-	GS::ErrCode				ExportClassificationsAndProperties(const API_Element& element, GS::ObjectState& os, const bool& sendProperties, const bool& sendListingParameters) const;
+	static void				AddLevel (GS::ObjectState& os, const API_StoryType& story, ResponseDictionary* dictionary);
+	GS::ErrCode				ExportProperties (const API_Element& element, const API_ElementMemo& memo, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, ResponseDictionary* dictionary, GS::ObjectState& os) const;
+	GS::ErrCode				ExportClassificationsAndProperties(const API_Element& element, const API_ElementMemo& memo, ResponseDictionary* dictionary, GS::ObjectState& os, const bool& sendProperties, const bool& sendListingParameters) const;
 
 	virtual GS::ErrCode		SerializeElementType (const API_Element& elem,
 												  const API_ElementMemo& memo,
+												  ResponseDictionary* dictionary,
 												  GS::ObjectState& os) const = 0;
 
 	GS::ErrCode				SerializeElementType (const API_Element& elem,
 												  const API_ElementMemo& memo,
+												  ResponseDictionary* dictionary,
 												  GS::ObjectState& os,
 												  const bool& sendProperties,
 												  const bool& sendListingParameters) const;
 
+	GS::ErrCode				SerializeElement (const API_Element& element,
+											  const API_ElementMemo& memo,
+											  bool sendProperties,
+											  bool sendListingParameters,
+											  ResponseDictionary* dictionary,
+											  GS::ObjectState& os) const;
+
 public:
 	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters,
 									 GS::ProcessControl& processControl) const override;
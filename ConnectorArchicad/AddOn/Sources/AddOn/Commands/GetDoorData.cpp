@@ -27,6 +27,7 @@ API_ElemTypeID GetDoorData::GetElemTypeID () const
 
 GS::ErrCode	GetDoorData::SerializeElementType (const API_Element& element,
 	const API_ElementMemo& /*memo*/,
+	ResponseDictionary* /*dictionary*/,
 	GS::ObjectState& os) const
 {
 	os.Add (ElementBase::ParentElementId, APIGuidToString (element.door.owner));
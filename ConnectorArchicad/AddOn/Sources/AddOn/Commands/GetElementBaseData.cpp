@@ -34,11 +34,12 @@ GS::UInt64 GetElementBaseData::GetMemoMask () const
 
 GS::ErrCode GetElementBaseData::SerializeElementType (const API_Element& elem,
 	const API_ElementMemo& /*memo*/,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	// Positioning
 	API_StoryType story = Utility::GetStory (elem.header.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	return NoError;
 }
@@ -3,15 +3,106 @@
 #include "ObjectState.hpp"
 #include "Utility.hpp"
 #include "FieldNames.hpp"
+#include "TypeNameTables.hpp"
+#include "ElementFilter.hpp"
 using namespace FieldNames;
 
 
 namespace AddOnCommands {
 
 
-static GS::Array<API_Guid> GetSelectedElementGuids ()
+/*!
+ Collects the enumerated element ids that pass the filter, optionally grouped by the element type names used by GetElementTypes
+ */
+class ElementIdCollector {
+public:
+	ElementIdCollector (bool groupByType, const ElementFilter& filter) : groupByType (groupByType), filter (filter) {}
+
+	void Add (const API_ElemType& elementType, const API_Guid& guid);
+	void Add (API_ElemTypeID typeID, const GS::Array<API_Guid>& guids);
+
+	void Store (GS::ObjectState& os) const;
+
+private:
+	bool														groupByType;
+	const ElementFilter&										filter;
+	GS::Array<API_Guid>											elementGuids;
+	GS::Array<GS::Pair<GS::UniString, GS::Array<API_Guid>>>	groups;
+	GS::HashTable<GS::UniString, UInt32>						groupIndices;
+};
+
+
+// the variations of these types have names of their own (e.g. the grid elements are objects), their type can't be told from the element list
+static bool HasVariationNames (API_ElemTypeID typeID)
+{
+	for (auto elementNameIt : elementNames) {
+		if (elementNameIt.key->typeID == typeID && elementNameIt.key->variationID != APIVarId_Generic)
+			return true;
+	}
+
+	return false;
+}
+
+
+void ElementIdCollector::Add (const API_ElemType& elementType, const API_Guid& guid)
+{
+	if (!filter.Matches (guid))
+		return;
+
+	if (!groupByType) {
+		elementGuids.Push (guid);
+		return;
+	}
+
+	GS::UniString elementTypeName;
+	if (NoError != GetElementTypeName (elementType, elementTypeName))
+		return;
+
+	UInt32 groupIndex = 0;
+	if (!groupIndices.Get (elementTypeName, &groupIndex)) {
+		groupIndex = groups.GetSize ();
+		groups.Push (GS::Pair<GS::UniString, GS::Array<API_Guid>> (elementTypeName, GS::Array<API_Guid> ()));
+		groupIndices.Add (elementTypeName, groupIndex);
+	}
+
+	groups[groupIndex].second.Push (guid);
+}
+
+
+void ElementIdCollector::Add (API_ElemTypeID typeID, const GS::Array<API_Guid>& guids)
+{
+	const bool hasVariationNames = groupByType && HasVariationNames (typeID);
+	for (const API_Guid& guid : guids)
+		Add (hasVariationNames ? Utility::GetElementType (guid) : API_ElemType (typeID), guid);
+}
+
+
+void ElementIdCollector::Store (GS::ObjectState& os) const
+{
+	if (!groupByType) {
+		const auto& listAdder = os.AddList<GS::UniString> (ElementBase::ApplicationIds);
+		for (const API_Guid& guid : elementGuids)
+			listAdder (APIGuidToString (guid));
+
+		return;
+	}
+
+	const auto& groupAdder = os.AddList<GS::ObjectState> (ElementBase::ElementTypes);
+	for (const auto& group : groups) {
+		GS::ObjectState groupOs;
+		groupOs.Add (ElementBase::ElementType, group.first);
+
+		const auto& listAdder = groupOs.AddList<GS::UniString> (ElementBase::ApplicationIds);
+		for (const API_Guid& guid : group.second)
+			listAdder (APIGuidToString (guid));
+
+		groupAdder (groupOs);
+	}
+}
+
+
+static void GetSelectedElementGuids (ElementIdCollector& collector)
 {
-	GS::Array<API_Guid>		elementGuids;
 	API_SelectionInfo		selectionInfo;
 	GS::Array<API_Neig>		selNeigs;
 
@@ -19,58 +110,46 @@ static GS::Array<API_Guid> GetSelectedElementGuids ()
 	if (err == NoError) {
 		if (selectionInfo.typeID != API_SelEmpty) {
 			for (const API_Neig& neig : selNeigs) {
-				if (Utility::IsElement3D (neig.guid)) {
-					elementGuids.Push (neig.guid);
+				const API_ElemType elementType = Utility::GetElementType (neig.guid);
+				if (Utility::Get3DElementTypes ().Contains (elementType.typeID)) {
+					collector.Add (elementType, neig.guid);
 				}
 			}
 		}
 	}
 
 	BMKillHandle ((GSHandle*) &selectionInfo.marquee.coords);
-
-	return elementGuids;
 }
 
 
-static GS::Array<API_Guid> GetAllElementGuids ()
+// the element list is queried per type, so the type of the listed elements is known without fetching their headers
+static void AddVisibleElementGuids (API_ElemTypeID typeID, ElementIdCollector& collector)
 {
-	GS::Array<API_Guid> elementGuids;
-	GS::Array<API_Guid> element3DGuids;
-	GSErrCode err = ACAPI_Element_GetElemList (API_ZombieElemID, &elementGuids, APIFilt_OnVisLayer | APIFilt_In3D);
-	if (err == NoError) {
-		for (const API_Guid& guid : elementGuids) {
-			if (Utility::IsElement3D (guid)) {
-				element3DGuids.Push (guid);
-			}
-		}
-	}
+	GS::Array<API_Guid> typeElementGuids;
+	GSErrCode err = ACAPI_Element_GetElemList (typeID, &typeElementGuids, APIFilt_OnVisLayer | APIFilt_In3D);
+	if (err == NoError)
+		collector.Add (typeID, typeElementGuids);
+}
+
 
-	return element3DGuids;
+static void GetAllElementGuids (ElementIdCollector& collector)
+{
+	for (API_ElemTypeID typeID : Utility::Get3DElementTypes ())
+		AddVisibleElementGuids (typeID, collector);
 }
 
 
-static GS::Array<API_Guid> GetElementsFilteredByElementTypes (GS::Array<GS::UniString>& elementTypes)
+static void GetElementsFilteredByElementTypes (const GS::Array<GS::UniString>& elementTypes, ElementIdCollector& collector)
 {
-	GS::Array<API_Guid> filteredGuids;
-	GS::Array<API_Guid> elementGuids;
-	GSErrCode err = ACAPI_Element_GetElemList (API_ZombieElemID, &elementGuids, APIFilt_OnVisLayer | APIFilt_In3D);
-	if (err == NoError) {
-		for (const API_Guid& guid : elementGuids) {
-			if (Utility::IsElement3D (guid)) {
-				API_Elem_Head elementHead = {};
-				elementHead.guid = guid;
-				err = ACAPI_Element_GetHeader (&elementHead);
-				if (err != NoError)
-					continue;
-
-				GS::UniString elementTypeName;
-				Utility::GetNonLocalizedElementTypeName (elementHead, elementTypeName);
-				if (elementTypes.Contains (elementTypeName))
-					filteredGuids.Push (guid);
-			}
-		}
+	for (API_ElemTypeID typeID : Utility::Get3DElementTypes ()) {
+		API_Elem_Head elementHead = {};
+		Utility::SetElementType (elementHead, typeID);
+
+		GS::UniString elementTypeName;
+		Utility::GetNonLocalizedElementTypeName (elementHead, elementTypeName);
+		if (elementTypes.Contains (elementTypeName))
+			AddVisibleElementGuids (typeID, collector);
 	}
-	return filteredGuids;
 }
 
 
@@ -85,24 +164,35 @@ GS::ObjectState GetElementIds::Execute (const GS::ObjectState& parameters, GS::P
 	GS::UniString elementFilter;
 	parameters.Get (ElementBase::ElementFilter, elementFilter);
 
-	GS::ObjectState retVal;
+	bool groupByType = false;
+	parameters.Get (ElementBase::GroupByType, groupByType);
+
+	ElementFilter filter;
+	if (parameters.Contains (ElementBase::FilterExpression)) {
+		GS::ObjectState filterExpression;
+		parameters.Get (ElementBase::FilterExpression, filterExpression);
+		GSErrCode err = filter.Parse (filterExpression);
+		if (err != NoError) {
+			GS::ObjectState retVal;
+			retVal.Add (FilterExpression::Error, err);
+			return retVal;
+		}
+	}
 
-	GS::Array<API_Guid> elementGuids;
+	ElementIdCollector collector (groupByType, filter);
 	if (elementFilter == "Selection")
-		elementGuids = GetSelectedElementGuids ();
+		GetSelectedElementGuids (collector);
 	else if (elementFilter == "All")
-		elementGuids = GetAllElementGuids ();
+		GetAllElementGuids (collector);
 	else if (elementFilter == "ElementType") {
 		GS::Array<GS::UniString> elementTypes;
 		parameters.Get (ElementBase::FilterBy, elementTypes);
 		if(elementTypes.GetSize() > 0)
-			elementGuids = GetElementsFilteredByElementTypes (elementTypes);
+			GetElementsFilteredByElementTypes (elementTypes, collector);
 	}
 
-	const auto& listAdder = retVal.AddList<GS::UniString> (ElementBase::ApplicationIds);
-	for (const API_Guid& guid : elementGuids) {
-		listAdder (APIGuidToString (guid));
-	}
+	GS::ObjectState retVal;
+	collector.Store (retVal);
 
 	return retVal;
 }
@@ -27,6 +27,7 @@ API_ElemTypeID GetGridElementData::GetElemTypeID () const
 
 GS::ErrCode	GetGridElementData::SerializeElementType (const API_Element& element,
 	const API_ElementMemo& memo,
+	ResponseDictionary* /*dictionary*/,
 	GS::ObjectState& os) const
 {
 	GS::UniString markerText;
@@ -11,6 +11,7 @@ class GetGridElementData : public GetDataCommand {
 	API_ElemTypeID		GetElemTypeID () const override;
 	GS::ErrCode			SerializeElementType (const API_Element& elem,
 							const API_ElementMemo& memo,
+							ResponseDictionary* dictionary,
 							GS::ObjectState& os) const override;
 
 public:
@@ -6,6 +6,7 @@
 #include "ModelInfo.hpp"
 #include "FieldNames.hpp"
 #include "Utility.hpp"
+#include "PerformanceStats.hpp"
 using namespace FieldNames;
 
 
@@ -203,6 +204,9 @@ static GS::Array<API_Guid> CheckForSubelements (const API_Guid& applicationId)
 
 static ModelInfo CalculateModelOfElement (const Modeler::Model3DViewer& modelViewer, const API_Guid& applicationId)
 {
+	static PerformanceStats::Counter& meshCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::MeshExtraction);
+	PerformanceStats::ScopedTimer timer (meshCounter);
+
 	ModelInfo modelInfo;
 	const Modeler::Attributes::Viewer& attributes (modelViewer.GetConstAttributesPtr ());
 
@@ -220,7 +224,7 @@ static ModelInfo CalculateModelOfElement (const Modeler::Model3DViewer& modelVie
 }
 
 
-static GS::ObjectState StoreModelOfElements (const GS::Array<API_Guid>&applicationIds)
+GS::ObjectState GetModelForElements::StoreModelOfElements (const GS::Array<API_Guid>& applicationIds, GS::ProcessControl& processControl) const
 {
 	GSErrCode err = ACAPI_View_ShowAllIn3D ();
 	if (err != NoError) {
@@ -242,7 +246,16 @@ static GS::ObjectState StoreModelOfElements (const GS::Array<API_Guid>&applicati
 
 	GS::ObjectState result;
 	const auto modelInserter = result.AddList<GS::ObjectState> (Models);
-	for (const auto& applicationId : applicationIds) {
+
+	StartProgress (processControl, Models, applicationIds.GetSize ());
+
+	for (UInt32 elementIndex = 0; elementIndex < applicationIds.GetSize (); elementIndex++) {
+		if (ReportProgress (processControl, elementIndex)) {
+			result.Add (Cancelled, true);
+			break;
+		}
+
+		const API_Guid& applicationId = applicationIds[elementIndex];
 		modelInserter (GS::ObjectState{ElementBase::ApplicationId, APIGuidToString (applicationId), Model::Model, CalculateModelOfElement (modelViewer, applicationId)});
 	}
 
@@ -256,12 +269,12 @@ GS::String GetModelForElements::GetName () const
 }
 
 
-GS::ObjectState GetModelForElements::Execute (const GS::ObjectState& parameters, GS::ProcessControl& /*processControl*/) const
+GS::ObjectState GetModelForElements::Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const
 {
 	GS::Array<GS::UniString> ids;
 	parameters.Get (ElementBase::ApplicationIds, ids);
 
-	return StoreModelOfElements (ids.Transform<API_Guid> ([] (const GS::UniString& idStr) { return APIGuidFromString (idStr.ToCStr ()); }));
+	return EncodeResponse (parameters, StoreModelOfElements (ids.Transform<API_Guid> ([] (const GS::UniString& idStr) { return APIGuidFromString (idStr.ToCStr ()); }), processControl));
 }
 
 
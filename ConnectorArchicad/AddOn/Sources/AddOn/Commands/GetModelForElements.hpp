@@ -11,6 +11,9 @@ class GetModelForElements : public BaseCommand {
 public:
 	virtual GS::String		GetName () const override;
 	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override;
+
+private:
+	GS::ObjectState			StoreModelOfElements (const GS::Array<API_Guid>& applicationIds, GS::ProcessControl& processControl) const;
 };
 
 
@@ -27,10 +27,11 @@ API_ElemTypeID GetObjectData::GetElemTypeID() const
 
 GS::ErrCode	GetObjectData::SerializeElementType (const API_Element& elem,
 	const API_ElementMemo& /*memo*/,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	API_StoryType story = Utility::GetStory (elem.object.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	double z = Utility::GetStoryLevel (elem.object.head.floorInd) + elem.object.level;
 	os.Add (Object::pos, Objects::Point3D (elem.object.pos.x, elem.object.pos.x, z));
@@ -27,6 +27,7 @@ API_ElemTypeID GetOpeningData::GetElemTypeID () const
 
 GS::ErrCode GetOpeningData::SerializeElementType (const API_Element& element,
   const API_ElementMemo& /*memo*/,
+  ResponseDictionary* /*dictionary*/,
   GS::ObjectState& os) const
 {
 	os.Add (ElementBase::ParentElementId, APIGuidToString (element.opening.owner));
@@ -0,0 +1,23 @@
+#include "GetPerformanceStats.hpp"
+#include "ResourceIds.hpp"
+#include "ObjectState.hpp"
+#include "PerformanceStats.hpp"
+
+
+namespace AddOnCommands
+{
+
+
+GS::String GetPerformanceStats::GetName () const
+{
+	return GetPerformanceStatsCommandName;
+}
+
+
+GS::ObjectState GetPerformanceStats::Execute (const GS::ObjectState& /*parameters*/, GS::ProcessControl& /*processControl*/) const
+{
+	return PerformanceStats::StoreAll ();
+}
+
+
+}
@@ -0,0 +1,20 @@
+#ifndef GET_PERFORMANCE_STATS_HPP
+#define GET_PERFORMANCE_STATS_HPP
+
+#include "BaseCommand.hpp"
+
+
+namespace AddOnCommands {
+
+
+class GetPerformanceStats : public BaseCommand {
+public:
+	virtual GS::String		GetName () const override;
+	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override;
+};
+
+
+}
+
+
+#endif
@@ -29,6 +29,7 @@ API_ElemTypeID GetRoofData::GetElemTypeID () const
 
 GS::ErrCode GetRoofData::SerializeElementType (const API_Element& element,
 	const API_ElementMemo& memo,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	// quantities
@@ -47,7 +48,7 @@ GS::ErrCode GetRoofData::SerializeElementType (const API_Element& element,
 	// Geometry and positioning
 	// The story of the shell
 	API_StoryType story = Utility::GetStory (element.roof.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	// The shape of the roof
 	double level = Utility::GetStoryLevel (element.roof.head.floorInd) + element.roof.shellBase.level;
@@ -31,12 +31,13 @@ API_ElemTypeID GetShellData::GetElemTypeID() const
 
 GS::ErrCode	GetShellData::SerializeElementType (const API_Element& element,
 	const API_ElementMemo& memo,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	// Geometry and positioning
 	// The story of the shell
 	API_StoryType story = Utility::GetStory (element.shell.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	// The shape of the shell
 	double level = Utility::GetStoryLevel (element.shell.head.floorInd) + element.shell.shellBase.level;
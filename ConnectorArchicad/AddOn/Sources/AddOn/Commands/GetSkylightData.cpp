@@ -27,6 +27,7 @@ API_ElemTypeID GetSkylightData::GetElemTypeID () const
 
 GS::ErrCode	GetSkylightData::SerializeElementType (const API_Element& element,
   const API_ElementMemo& /*memo*/,
+  ResponseDictionary* /*dictionary*/,
   GS::ObjectState& os) const
 {
 	os.Add (ElementBase::ParentElementId, APIGuidToString (element.skylight.owner));
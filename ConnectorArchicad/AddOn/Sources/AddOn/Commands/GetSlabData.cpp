@@ -28,12 +28,13 @@ API_ElemTypeID GetSlabData::GetElemTypeID () const
 
 GS::ErrCode GetSlabData::SerializeElementType (const API_Element& element,
 	const API_ElementMemo& memo,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	// Geometry and positioning
 	// The index of the slab's floor
 	API_StoryType story = Utility::GetStory (element.slab.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	// The shape of the slab
 	double level = Utility::GetStoryLevel (element.slab.head.floorInd) + element.slab.level;
@@ -31,6 +31,7 @@ API_ElemTypeID GetWallData::GetElemTypeID () const
 
 GS::ErrCode GetWallData::SerializeElementType (const API_Element& element,
 	const API_ElementMemo& memo,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	const API_WallType wall = element.wall;
@@ -39,7 +40,7 @@ GS::ErrCode GetWallData::SerializeElementType (const API_Element& element,
 
 	// The story of the wall
 	API_StoryType story = Utility::GetStory (wall.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	// Base offset of the wall
 	os.Add (Wall::BaseOffset, wall.bottomOffset);
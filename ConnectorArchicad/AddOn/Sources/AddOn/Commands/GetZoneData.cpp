@@ -28,6 +28,7 @@ API_ElemTypeID GetZoneData::GetElemTypeID () const
 
 GS::ErrCode GetZoneData::SerializeElementType (const API_Element& element,
 	const API_ElementMemo& memo,
+	ResponseDictionary* dictionary,
 	GS::ObjectState& os) const
 {
 	// quantities
@@ -51,7 +52,7 @@ GS::ErrCode GetZoneData::SerializeElementType (const API_Element& element,
 
 	// The index of the room's floor
 	API_StoryType story = Utility::GetStory (element.zone.head.floorInd);
-	os.Add (ElementBase::Level, Objects::Level (story));
+	AddLevel (os, story, dictionary);
 
 	// The base point of the room
 	double level = Utility::GetStoryLevel (element.zone.head.floorInd) + element.zone.roomBaseLev + element.zone.roomFlThick;
@@ -0,0 +1,34 @@
+#include "RemoveUnusedLibraryParts.hpp"
+#include "ResourceIds.hpp"
+#include "ObjectState.hpp"
+#include "LibpartImportManager.hpp"
+
+
+namespace AddOnCommands
+{
+
+
+GS::String RemoveUnusedLibraryParts::GetName () const
+{
+	return RemoveUnusedLibraryPartsCommandName;
+}
+
+
+/*!
+ Remove the generated library parts that are not used by any object from the embedded library
+ */
+GS::ObjectState RemoveUnusedLibraryParts::Execute (const GS::ObjectState& /*parameters*/, GS::ProcessControl& /*processControl*/) const
+{
+	// keep the manager of a receive in progress
+	const bool hadInstance = LibpartImportManager::HasInstance ();
+
+	LibpartImportManager::GetInstance ()->RemoveUnusedLibraryParts ();
+
+	if (!hadInstance)
+		LibpartImportManager::DeleteInstance ();
+
+	return {};
+}
+
+
+}
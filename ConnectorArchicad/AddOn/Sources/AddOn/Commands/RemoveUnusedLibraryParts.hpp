@@ -0,0 +1,20 @@
+#ifndef REMOVE_UNUSED_LIBRARY_PARTS_HPP
+#define REMOVE_UNUSED_LIBRARY_PARTS_HPP
+
+#include "BaseCommand.hpp"
+
+
+namespace AddOnCommands {
+
+
+class RemoveUnusedLibraryParts : public BaseCommand {
+public:
+	virtual GS::String		GetName () const override;
+	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override;
+};
+
+
+}
+
+
+#endif
@@ -0,0 +1,25 @@
+#include "ResetPerformanceStats.hpp"
+#include "ResourceIds.hpp"
+#include "ObjectState.hpp"
+#include "PerformanceStats.hpp"
+
+
+namespace AddOnCommands
+{
+
+
+GS::String ResetPerformanceStats::GetName () const
+{
+	return ResetPerformanceStatsCommandName;
+}
+
+
+GS::ObjectState ResetPerformanceStats::Execute (const GS::ObjectState& /*parameters*/, GS::ProcessControl& /*processControl*/) const
+{
+	PerformanceStats::ResetAll ();
+
+	return {};
+}
+
+
+}
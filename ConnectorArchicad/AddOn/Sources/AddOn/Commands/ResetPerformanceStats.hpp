@@ -0,0 +1,20 @@
+#ifndef RESET_PERFORMANCE_STATS_HPP
+#define RESET_PERFORMANCE_STATS_HPP
+
+#include "BaseCommand.hpp"
+
+
+namespace AddOnCommands {
+
+
+class ResetPerformanceStats : public BaseCommand {
+public:
+	virtual GS::String		GetName () const override;
+	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override;
+};
+
+
+}
+
+
+#endif
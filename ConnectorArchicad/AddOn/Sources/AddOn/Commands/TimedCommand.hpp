@@ -0,0 +1,30 @@
+#ifndef TIMED_COMMAND_HPP
+#define TIMED_COMMAND_HPP
+
+#include "BaseCommand.hpp"
+#include "PerformanceStats.hpp"
+
+
+namespace AddOnCommands {
+
+
+/*!
+ Wraps a command to collect the timings of its Execute in the "Command.<name>" performance counter
+ */
+template <typename CommandType>
+class TimedCommand : public CommandType {
+public:
+	virtual GS::ObjectState	Execute (const GS::ObjectState& parameters, GS::ProcessControl& processControl) const override
+	{
+		static PerformanceStats::Counter& counter = PerformanceStats::GetCounter (GS::String ("Command.") + this->GetName ());
+		PerformanceStats::ScopedTimer timer (counter);
+
+		return CommandType::Execute (parameters, processControl);
+	}
+};
+
+
+}
+
+
+#endif
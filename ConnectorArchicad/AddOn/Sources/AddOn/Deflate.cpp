@@ -0,0 +1,236 @@
+#include "Deflate.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+namespace Deflate {
+
+
+/*!
+ The Adler-32 checksum (RFC 1950) of the data
+ */
+UInt32 Adler32 (const std::string& data)
+{
+	// the sums can't overflow in this many steps before the modulo
+	static const size_t BlockSize = 5552;
+	static const UInt32 Base = 65521;
+
+	UInt32 a = 1;
+	UInt32 b = 0;
+	size_t i = 0;
+	while (i < data.size ()) {
+		const size_t blockEnd = std::min (data.size (), i + BlockSize);
+		for (; i < blockEnd; i++) {
+			a += (unsigned char) data[i];
+			b += a;
+		}
+		a %= Base;
+		b %= Base;
+	}
+
+	return (b << 16) | a;
+}
+
+
+class BitWriter {
+public:
+	explicit BitWriter (std::string& output) : output (output), bitBuffer (0), bitCount (0) {}
+
+	// the bits of the values are written from the least significant one
+	void Write (UInt32 value, UInt32 count)
+	{
+		bitBuffer |= (GS::UInt64) value << bitCount;
+		bitCount += count;
+		while (bitCount >= 8) {
+			output.push_back ((char) (bitBuffer & 0xFF));
+			bitBuffer >>= 8;
+			bitCount -= 8;
+		}
+	}
+
+	// the Huffman codes are written from the most significant bit
+	void WriteCode (UInt32 code, UInt32 length)
+	{
+		UInt32 reversed = 0;
+		for (UInt32 i = 0; i < length; i++)
+			reversed |= ((code >> i) & 1) << (length - 1 - i);
+
+		Write (reversed, length);
+	}
+
+	void Flush ()
+	{
+		if (bitCount > 0)
+			output.push_back ((char) (bitBuffer & 0xFF));
+
+		bitBuffer = 0;
+		bitCount = 0;
+	}
+
+private:
+	std::string&	output;
+	GS::UInt64		bitBuffer;
+	UInt32			bitCount;
+};
+
+
+static const UInt32 LengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const UInt32 LengthExtraBits[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const UInt32 DistanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const UInt32 DistanceExtraBits[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+
+static void WriteLiteralOrLength (BitWriter& writer, UInt32 symbol)
+{
+	if (symbol < 144)
+		writer.WriteCode (0x30 + symbol, 8);
+	else if (symbol < 256)
+		writer.WriteCode (0x190 + symbol - 144, 9);
+	else if (symbol < 280)
+		writer.WriteCode (symbol - 256, 7);
+	else
+		writer.WriteCode (0xC0 + symbol - 280, 8);
+}
+
+
+static void WriteMatch (BitWriter& writer, UInt32 length, UInt32 distance)
+{
+	UInt32 lengthCode = 0;
+	while (lengthCode + 1 < 29 && LengthBase[lengthCode + 1] <= length)
+		lengthCode++;
+
+	WriteLiteralOrLength (writer, 257 + lengthCode);
+	writer.Write (length - LengthBase[lengthCode], LengthExtraBits[lengthCode]);
+
+	UInt32 distanceCode = 0;
+	while (distanceCode + 1 < 30 && DistanceBase[distanceCode + 1] <= distance)
+		distanceCode++;
+
+	writer.WriteCode (distanceCode, 5);
+	writer.Write (distance - DistanceBase[distanceCode], DistanceExtraBits[distanceCode]);
+}
+
+
+/*!
+ Compress into a single deflate block with the fixed Huffman codes
+ The JSON of the elements is very repetitive, the back references do most of the work, a dynamic Huffman table would gain little for its cost.
+ @param data The bytes to compress
+ @param compressed The raw deflate stream (out)
+ */
+void Compress (const std::string& data, std::string& compressed)
+{
+	static const size_t WindowSize = 32768;
+	static const UInt32 MinMatch = 3;
+	static const UInt32 MaxMatch = 258;
+	static const UInt32 HashBits = 15;
+	static const UInt32 MaxChainLength = 64;
+
+	const unsigned char* bytes = (const unsigned char*) data.data ();
+	const size_t size = data.size ();
+
+	// the chains store the position + 1 of the earlier occurrences of the same 3 bytes, 0 ends the chain
+	std::vector<size_t> head ((size_t) 1 << HashBits, 0);
+	std::vector<size_t> previous (WindowSize, 0);
+
+	const auto hash = [bytes] (size_t pos) -> size_t {
+		return ((bytes[pos] << 10) ^ (bytes[pos + 1] << 5) ^ bytes[pos + 2]) & ((1 << HashBits) - 1);
+	};
+	const auto insert = [&] (size_t pos) {
+		if (pos + MinMatch > size)
+			return;
+
+		const size_t h = hash (pos);
+		previous[pos % WindowSize] = head[h];
+		head[h] = pos + 1;
+	};
+
+	compressed.reserve (size / 4);
+	BitWriter writer (compressed);
+
+	// final block, fixed Huffman codes
+	writer.Write (1, 1);
+	writer.Write (1, 2);
+
+	size_t pos = 0;
+	while (pos < size) {
+		UInt32 bestLength = 0;
+		size_t bestDistance = 0;
+
+		if (pos + MinMatch <= size) {
+			const UInt32 maxLength = (UInt32) std::min<size_t> (MaxMatch, size - pos);
+			size_t candidate = head[hash (pos)];
+			for (UInt32 chainLength = 0; candidate != 0 && chainLength < MaxChainLength; chainLength++) {
+				const size_t candidatePos = candidate - 1;
+				const size_t distance = pos - candidatePos;
+				if (distance > WindowSize)
+					break;
+
+				UInt32 length = 0;
+				while (length < maxLength && bytes[candidatePos + length] == bytes[pos + length])
+					length++;
+
+				if (length > bestLength) {
+					bestLength = length;
+					bestDistance = distance;
+					if (length == maxLength)
+						break;
+				}
+
+				candidate = previous[candidatePos % WindowSize];
+			}
+		}
+
+		if (bestLength >= MinMatch) {
+			WriteMatch (writer, bestLength, (UInt32) bestDistance);
+			for (UInt32 i = 0; i < bestLength; i++)
+				insert (pos + i);
+
+			pos += bestLength;
+		} else {
+			WriteLiteralOrLength (writer, bytes[pos]);
+			insert (pos);
+			pos++;
+		}
+	}
+
+	// end of block
+	WriteLiteralOrLength (writer, 256);
+	writer.Flush ();
+}
+
+
+/*!
+ The standard base64 encoding (RFC 4648) of the data, padded to whole groups of four characters
+ */
+std::string ToBase64 (const std::string& data)
+{
+	static const char* Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	const unsigned char* bytes = (const unsigned char*) data.data ();
+	std::string encoded;
+	encoded.reserve ((data.size () + 2) / 3 * 4);
+
+	size_t i = 0;
+	for (; i + 2 < data.size (); i += 3) {
+		const UInt32 triple = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+		encoded.push_back (Alphabet[(triple >> 18) & 0x3F]);
+		encoded.push_back (Alphabet[(triple >> 12) & 0x3F]);
+		encoded.push_back (Alphabet[(triple >> 6) & 0x3F]);
+		encoded.push_back (Alphabet[triple & 0x3F]);
+	}
+
+	if (i < data.size ()) {
+		const bool hasSecondByte = i + 1 < data.size ();
+		const UInt32 triple = (bytes[i] << 16) | (hasSecondByte ? bytes[i + 1] << 8 : 0);
+		encoded.push_back (Alphabet[(triple >> 18) & 0x3F]);
+		encoded.push_back (Alphabet[(triple >> 12) & 0x3F]);
+		encoded.push_back (hasSecondByte ? Alphabet[(triple >> 6) & 0x3F] : '=');
+		encoded.push_back ('=');
+	}
+
+	return encoded;
+}
+
+
+}
@@ -0,0 +1,21 @@
+#ifndef DEFLATE_HPP
+#define DEFLATE_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+
+#include <string>
+
+
+// The compression of the response envelope, independent of the Archicad API apart from the basic types
+namespace Deflate {
+
+
+UInt32		Adler32 (const std::string& data);
+void		Compress (const std::string& data, std::string& compressed);
+std::string	ToBase64 (const std::string& data);
+
+
+}
+
+#endif
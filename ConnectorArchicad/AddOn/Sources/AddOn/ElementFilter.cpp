@@ -0,0 +1,519 @@
+#include "ElementFilter.hpp"
+
+#include "APIMigrationHelper.hpp"
+#include "FieldNames.hpp"
+#include "Objects/Point.hpp"
+#include "RealNumber.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <vector>
+
+using namespace FieldNames;
+
+
+// the element data used by the predicates, each part is fetched on first use
+class ElementFilter::Element {
+public:
+	explicit Element (const API_Guid& guid) : guid (guid) {}
+
+	const API_Guid&									GetGuid () const { return guid; }
+	const API_Elem_Head*							GetHeader ();
+	const API_Box3D*								GetBounds ();
+	const GS::Array<GS::Pair<API_Guid, API_Guid>>*	GetClassificationItems ();
+
+private:
+	API_Guid								guid;
+
+	bool									headerFetched = false;
+	GSErrCode								headerError = NoError;
+	API_Elem_Head							header{};
+
+	bool									boundsFetched = false;
+	GSErrCode								boundsError = NoError;
+	API_Box3D								bounds{};
+
+	bool									classificationItemsFetched = false;
+	GSErrCode								classificationItemsError = NoError;
+	GS::Array<GS::Pair<API_Guid, API_Guid>>	classificationItems;
+};
+
+
+const API_Elem_Head* ElementFilter::Element::GetHeader ()
+{
+	if (!headerFetched) {
+		headerFetched = true;
+		header.guid = guid;
+		headerError = ACAPI_Element_GetHeader (&header);
+	}
+
+	return headerError == NoError ? &header : nullptr;
+}
+
+
+const API_Box3D* ElementFilter::Element::GetBounds ()
+{
+	if (!boundsFetched) {
+		boundsFetched = true;
+		const API_Elem_Head* elementHeader = GetHeader ();
+		boundsError = elementHeader != nullptr ? ACAPI_Element_CalcBounds (elementHeader, &bounds) : Error;
+	}
+
+	return boundsError == NoError ? &bounds : nullptr;
+}
+
+
+const GS::Array<GS::Pair<API_Guid, API_Guid>>* ElementFilter::Element::GetClassificationItems ()
+{
+	if (!classificationItemsFetched) {
+		classificationItemsFetched = true;
+		classificationItemsError = ACAPI_Element_GetClassificationItems (guid, classificationItems);
+	}
+
+	return classificationItemsError == NoError ? &classificationItems : nullptr;
+}
+
+
+class ElementFilter::Predicate {
+public:
+	// the relative costs of the leaves, the operands of and/or are evaluated in this order
+	enum Cost {
+		HeaderCost = 1,
+		BoundsCost = 2,
+		ClassificationCost = 3,
+		PropertyCost = 4
+	};
+
+	virtual ~Predicate () = default;
+
+	virtual UInt32	GetCost () const = 0;
+	virtual bool	Matches (Element& element) const = 0;
+};
+
+
+namespace {
+
+using PredicatePtr = std::unique_ptr<ElementFilter::Predicate>;
+
+
+class CombinedPredicate : public ElementFilter::Predicate {
+public:
+	CombinedPredicate (bool allOf, std::vector<PredicatePtr>&& predicates) :
+		allOf (allOf),
+		operands (std::move (predicates))
+	{
+		std::stable_sort (operands.begin (), operands.end (), [] (const PredicatePtr& a, const PredicatePtr& b) {
+			return a->GetCost () < b->GetCost ();
+		});
+	}
+
+	virtual UInt32 GetCost () const override
+	{
+		return operands.empty () ? 0 : operands.back ()->GetCost ();
+	}
+
+	virtual bool Matches (ElementFilter::Element& element) const override
+	{
+		for (const auto& operand : operands) {
+			if (operand->Matches (element) != allOf)
+				return !allOf;
+		}
+
+		return allOf;
+	}
+
+private:
+	bool						allOf;
+	std::vector<PredicatePtr>	operands;
+};
+
+
+class NotPredicate : public ElementFilter::Predicate {
+public:
+	explicit NotPredicate (PredicatePtr&& operand) : operand (std::move (operand)) {}
+
+	virtual UInt32	GetCost () const override { return operand->GetCost (); }
+	virtual bool	Matches (ElementFilter::Element& element) const override { return !operand->Matches (element); }
+
+private:
+	PredicatePtr operand;
+};
+
+
+class LayerPredicate : public ElementFilter::Predicate {
+public:
+	explicit LayerPredicate (const GS::Array<GS::UniString>& layerNames)
+	{
+		for (const GS::UniString& layerName : layerNames) {
+			GS::UniString name (layerName);
+			API_Attribute attribute;
+			BNZeroMemory (&attribute, sizeof (API_Attribute));
+			attribute.header.typeID = API_LayerID;
+			attribute.header.uniStringNamePtr = &name;
+			if (ACAPI_Attribute_Get (&attribute) == NoError)
+				layers.Push (attribute.header.index);
+		}
+	}
+
+	virtual UInt32 GetCost () const override { return HeaderCost; }
+
+	virtual bool Matches (ElementFilter::Element& element) const override
+	{
+		const API_Elem_Head* header = element.GetHeader ();
+		return header != nullptr && layers.Contains (header->layer);
+	}
+
+private:
+	GS::Array<API_AttributeIndex> layers;
+};
+
+
+class FloorPredicate : public ElementFilter::Predicate {
+public:
+	FloorPredicate (Int32 from, Int32 to) : from (from), to (to) {}
+
+	virtual UInt32 GetCost () const override { return HeaderCost; }
+
+	virtual bool Matches (ElementFilter::Element& element) const override
+	{
+		const API_Elem_Head* header = element.GetHeader ();
+		return header != nullptr && header->floorInd >= from && header->floorInd <= to;
+	}
+
+private:
+	Int32 from;
+	Int32 to;
+};
+
+
+class BoundingBoxPredicate : public ElementFilter::Predicate {
+public:
+	BoundingBoxPredicate (const Objects::Point3D& min, const Objects::Point3D& max) : min (min), max (max) {}
+
+	virtual UInt32 GetCost () const override { return BoundsCost; }
+
+	virtual bool Matches (ElementFilter::Element& element) const override
+	{
+		const API_Box3D* bounds = element.GetBounds ();
+		return bounds != nullptr &&
+			bounds->xMin <= max.x && bounds->xMax >= min.x &&
+			bounds->yMin <= max.y && bounds->yMax >= min.y &&
+			bounds->zMin <= max.z && bounds->zMax >= min.z;
+	}
+
+private:
+	Objects::Point3D min;
+	Objects::Point3D max;
+};
+
+
+class ClassificationPredicate : public ElementFilter::Predicate {
+public:
+	ClassificationPredicate (const GS::UniString& systemName, const GS::UniString& codePrefix) : codePrefix (codePrefix)
+	{
+		GS::Array<API_ClassificationSystem> systems;
+		if (ACAPI_Classification_GetClassificationSystems (systems) != NoError)
+			return;
+
+		for (const API_ClassificationSystem& system : systems) {
+			if (system.name == systemName)
+				systemGuids.Add (system.guid);
+		}
+	}
+
+	virtual UInt32 GetCost () const override { return ClassificationCost; }
+
+	virtual bool Matches (ElementFilter::Element& element) const override
+	{
+		if (systemGuids.IsEmpty ())
+			return false;
+
+		const GS::Array<GS::Pair<API_Guid, API_Guid>>* systemItemPairs = element.GetClassificationItems ();
+		if (systemItemPairs == nullptr)
+			return false;
+
+		for (const auto& systemItemPair : *systemItemPairs) {
+			if (!systemGuids.Contains (systemItemPair.first))
+				continue;
+
+			// the elements share a few classification items, their codes are looked up once
+			const GS::UniString* code = itemCodes.GetPtr (systemItemPair.second);
+			if (code == nullptr) {
+				API_ClassificationItem item;
+				item.guid = systemItemPair.second;
+				if (ACAPI_Classification_GetClassificationItem (item) != NoError)
+					continue;
+
+				itemCodes.Add (systemItemPair.second, item.id);
+				code = itemCodes.GetPtr (systemItemPair.second);
+			}
+
+			if (code->BeginsWith (codePrefix))
+				return true;
+		}
+
+		return false;
+	}
+
+private:
+	GS::HashSet<API_Guid>								systemGuids;
+	GS::UniString										codePrefix;
+	mutable GS::HashTable<API_Guid, GS::UniString>		itemCodes;
+};
+
+
+// parses the whole text as a number with '.' as decimal separator, whatever the locale of Archicad is
+static bool ParseNumber (const GS::UniString& text, double& number)
+{
+	std::istringstream stream (text.ToCStr ().Get ());
+	stream.imbue (std::locale::classic ());
+	stream >> number;
+	if (stream.fail ())
+		return false;
+
+	stream >> std::ws;
+	return stream.eof ();
+}
+
+
+class PropertyPredicate : public ElementFilter::Predicate {
+public:
+	PropertyPredicate (const GS::UniString& groupName, const GS::UniString& propertyName, const GS::UniString& value) :
+		definitionGuid (APINULLGuid),
+		value (value),
+		isNumber (ParseNumber (value, number))
+	{
+		GS::Array<API_PropertyGroup> groups;
+		if (ACAPI_Property_GetPropertyGroups (groups) != NoError)
+			return;
+
+		for (const API_PropertyGroup& group : groups) {
+			if (group.name != groupName)
+				continue;
+
+			GS::Array<API_PropertyDefinition> definitions;
+			if (ACAPI_Property_GetPropertyDefinitions (group.guid, definitions) != NoError)
+				continue;
+
+			for (const API_PropertyDefinition& definition : definitions) {
+				if (definition.name == propertyName) {
+					definitionGuid = definition.guid;
+					return;
+				}
+			}
+		}
+	}
+
+	virtual UInt32 GetCost () const override { return PropertyCost; }
+
+	virtual bool Matches (ElementFilter::Element& element) const override
+	{
+		if (definitionGuid == APINULLGuid)
+			return false;
+
+		API_Property property;
+		if (ACAPI_Element_GetPropertyValue (element.GetGuid (), definitionGuid, property) != NoError)
+			return false;
+
+		return ValueEquals (property);
+	}
+
+private:
+	bool ValueEquals (const API_Property& property) const
+	{
+		if (property.status != API_Property_HasValue || property.value.variantStatus != API_VariantStatusNormal)
+			return false;
+
+		if (property.definition.collectionType != API_PropertySingleCollectionType &&
+			property.definition.collectionType != API_PropertySingleChoiceEnumerationCollectionType)
+			return false;
+
+		const API_Variant& variant = property.value.singleVariant.variant;
+		switch (variant.type) {
+			case API_PropertyIntegerValueType:
+			case API_PropertyRealValueType:
+			{
+				if (!isNumber)
+					return false;
+
+				const double propertyNumber = variant.type == API_PropertyIntegerValueType ? variant.intValue : variant.doubleValue;
+				return std::fabs (propertyNumber - number) < EPS;
+			}
+			case API_PropertyStringValueType:
+				return variant.uniStringValue == value;
+			case API_PropertyBooleanValueType:
+				return value == (variant.boolValue ? "true" : "false");
+			case API_PropertyGuidValueType:
+				for (const auto& possibleEnumValue : property.definition.possibleEnumValues) {
+					if (possibleEnumValue.keyVariant.guidValue == variant.guidValue)
+						return possibleEnumValue.displayVariant.uniStringValue == value;
+				}
+				return false;
+			default:
+				return false;
+		}
+	}
+
+	API_Guid		definitionGuid;
+	GS::UniString	value;
+	double			number = 0.0;
+	bool			isNumber;
+};
+
+
+GSErrCode ParsePredicate (const GS::ObjectState& os, PredicatePtr& predicate);
+
+
+GSErrCode ParseOperands (const GS::ObjectState& os, const char* fieldName, std::vector<PredicatePtr>& operands)
+{
+	GS::Array<GS::ObjectState> operandOss;
+	os.Get (fieldName, operandOss);
+	if (operandOss.IsEmpty ())
+		return Error;
+
+	for (const GS::ObjectState& operandOs : operandOss) {
+		PredicatePtr operand;
+		GSErrCode err = ParsePredicate (operandOs, operand);
+		if (err != NoError)
+			return err;
+
+		operands.push_back (std::move (operand));
+	}
+
+	return NoError;
+}
+
+
+GSErrCode ParsePredicate (const GS::ObjectState& os, PredicatePtr& predicate)
+{
+	std::vector<PredicatePtr> predicates;
+
+	if (os.Contains (FilterExpression::And)) {
+		std::vector<PredicatePtr> operands;
+		GSErrCode err = ParseOperands (os, FilterExpression::And, operands);
+		if (err != NoError)
+			return err;
+
+		predicates.push_back (PredicatePtr (new CombinedPredicate (true, std::move (operands))));
+	}
+
+	if (os.Contains (FilterExpression::Or)) {
+		std::vector<PredicatePtr> operands;
+		GSErrCode err = ParseOperands (os, FilterExpression::Or, operands);
+		if (err != NoError)
+			return err;
+
+		predicates.push_back (PredicatePtr (new CombinedPredicate (false, std::move (operands))));
+	}
+
+	if (os.Contains (FilterExpression::Not)) {
+		GS::ObjectState operandOs;
+		os.Get (FilterExpression::Not, operandOs);
+
+		PredicatePtr operand;
+		GSErrCode err = ParsePredicate (operandOs, operand);
+		if (err != NoError)
+			return err;
+
+		predicates.push_back (PredicatePtr (new NotPredicate (std::move (operand))));
+	}
+
+	if (os.Contains (FilterExpression::Layers)) {
+		GS::Array<GS::UniString> layerNames;
+		os.Get (FilterExpression::Layers, layerNames);
+
+		predicates.push_back (PredicatePtr (new LayerPredicate (layerNames)));
+	}
+
+	if (os.Contains (FilterExpression::Floors)) {
+		GS::ObjectState floorsOs;
+		os.Get (FilterExpression::Floors, floorsOs);
+
+		Int32 from = std::numeric_limits<Int32>::min ();
+		Int32 to = std::numeric_limits<Int32>::max ();
+		floorsOs.Get (FilterExpression::From, from);
+		floorsOs.Get (FilterExpression::To, to);
+
+		predicates.push_back (PredicatePtr (new FloorPredicate (from, to)));
+	}
+
+	if (os.Contains (FilterExpression::BoundingBox)) {
+		GS::ObjectState boxOs;
+		os.Get (FilterExpression::BoundingBox, boxOs);
+
+		Objects::Point3D min;
+		Objects::Point3D max;
+		boxOs.Get (FilterExpression::Min, min);
+		boxOs.Get (FilterExpression::Max, max);
+
+		predicates.push_back (PredicatePtr (new BoundingBoxPredicate (min, max)));
+	}
+
+	if (os.Contains (FilterExpression::Classification)) {
+		GS::ObjectState classificationOs;
+		os.Get (FilterExpression::Classification, classificationOs);
+
+		GS::UniString systemName;
+		GS::UniString codePrefix;
+		classificationOs.Get (FilterExpression::System, systemName);
+		classificationOs.Get (FilterExpression::CodePrefix, codePrefix);
+
+		predicates.push_back (PredicatePtr (new ClassificationPredicate (systemName, codePrefix)));
+	}
+
+	if (os.Contains (FilterExpression::Property)) {
+		GS::ObjectState propertyOs;
+		os.Get (FilterExpression::Property, propertyOs);
+
+		GS::UniString groupName;
+		GS::UniString propertyName;
+		GS::UniString value;
+		propertyOs.Get (FilterExpression::Group, groupName);
+		propertyOs.Get (FilterExpression::Name, propertyName);
+		propertyOs.Get (FilterExpression::Value, value);
+
+		predicates.push_back (PredicatePtr (new PropertyPredicate (groupName, propertyName, value)));
+	}
+
+	if (predicates.empty ())
+		return Error;
+
+	if (predicates.size () == 1)
+		predicate = std::move (predicates.front ());
+	else
+		predicate = PredicatePtr (new CombinedPredicate (true, std::move (predicates)));
+
+	return NoError;
+}
+
+}
+
+
+ElementFilter::ElementFilter () = default;
+
+
+ElementFilter::~ElementFilter () = default;
+
+
+/*!
+ Build the filter from an expression
+ @param expression The filter expression sent by the connector
+ @return An error code (NoError = success), Error if a part of the expression has no known predicate
+ */
+GSErrCode ElementFilter::Parse (const GS::ObjectState& expression)
+{
+	return ParsePredicate (expression, root);
+}
+
+
+bool ElementFilter::Matches (const API_Guid& guid) const
+{
+	if (root == nullptr)
+		return true;
+
+	Element element (guid);
+	return root->Matches (element);
+}
@@ -0,0 +1,35 @@
+#ifndef ELEMENT_FILTER_HPP
+#define ELEMENT_FILTER_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+#include "ObjectState.hpp"
+
+#include <memory>
+
+
+/*!
+ Element filter expression evaluated in the add-on
+ The leaves test the layer, the floor index range, the 3D bounds, the classification code prefix or a property value,
+ they are combined with and/or/not, and the leaves listed in one object must all match.
+ The names in the expression are resolved once, the element data is fetched on first use and the operands are evaluated cheapest first.
+ */
+class ElementFilter {
+public:
+	class Element;
+	class Predicate;
+
+	ElementFilter ();
+	~ElementFilter ();
+
+	ElementFilter (const ElementFilter&) = delete;
+	void operator= (const ElementFilter&) = delete;
+
+	GSErrCode	Parse (const GS::ObjectState& expression);
+	bool		Matches (const API_Guid& guid) const;
+
+private:
+	std::unique_ptr<Predicate>	root;
+};
+
+#endif
@@ -18,7 +18,85 @@ namespace FieldNames
 		static const char* CreatedIds = "CreatedIds";
 		static const char* Log = "Log";
 	}
+
+	namespace StageTimings {
+		static const char* StageTimings = "stageTimings";
+		static const char* DecodeTime = "decodeTime";
+		static const char* ApplyTime = "applyTime";
+	}
+
+	namespace ClassificationImport {
+		static const char* ClassificationImport = "classificationImport";
+		static const char* Skipped = "skipped";
+		static const char* Applied = "applied";
+	}
+
+	namespace ElementUpdates {
+		static const char* ElementUpdates = "elementUpdates";
+		static const char* Skipped = "skipped";
+		static const char* Changed = "changed";
+	}
 	
+	static const char* Cancelled = "cancelled";
+
+	namespace FilterExpression {
+		static const char* And = "and";
+		static const char* Or = "or";
+		static const char* Not = "not";
+		static const char* Layers = "layers";
+		static const char* Floors = "floors";
+		static const char* From = "from";
+		static const char* To = "to";
+		static const char* BoundingBox = "boundingBox";
+		static const char* Min = "min";
+		static const char* Max = "max";
+		static const char* Classification = "classification";
+		static const char* System = "system";
+		static const char* CodePrefix = "codePrefix";
+		static const char* Property = "property";
+		static const char* Group = "group";
+		static const char* Name = "name";
+		static const char* Value = "value";
+		static const char* Error = "filterExpressionError";
+	}
+
+	namespace Changes {
+		static const char* JournalId = "journalId";
+		static const char* Sequence = "sequence";
+		static const char* Overflow = "overflow";
+		static const char* Created = "created";
+		static const char* Modified = "modified";
+		static const char* Deleted = "deleted";
+	}
+
+	namespace ResponseEncoding {
+		static const char* ResponseEncoding = "responseEncoding";
+		static const char* Deflate = "deflate";
+		static const char* Encoding = "encoding";
+		static const char* Payload = "payload";
+		static const char* Size = "size";
+		static const char* Checksum = "checksum";
+	}
+
+	namespace Dictionaries {
+		static const char* UseDictionaries = "useDictionaries";
+		static const char* Dictionaries = "dictionaries";
+		static const char* Levels = "levels";
+		static const char* Layers = "layers";
+		static const char* Materials = "materials";
+		static const char* PropertyGroups = "propertyGroups";
+		static const char* PropertyNames = "propertyNames";
+			// the fields of the values given by their index in a table
+		static const char* LevelIndex = "levelIndex";
+		static const char* LayerIndex = "layerIndex";
+		static const char* MaterialIndex = "materialIndex";
+		static const char* NameIndex = "nameIndex";
+	}
+
+	namespace Connector {
+		static const char* Show = "show";
+	}
+
 	namespace ElementBase
 	{
 		static const char* Id = "id";
@@ -27,6 +105,8 @@ namespace FieldNames
 		static const char* ParentElementId = "parentApplicationId";
 		static const char* ElementFilter = "elementFilter";
 		static const char* FilterBy = "filterBy";
+		static const char* GroupByType = "groupByType";
+		static const char* FilterExpression = "filterExpression";
 		static const char* ElementType = "elementType";
 		static const char* ElementTypes = "elementTypes";
 		static const char* Elements = "elements";
@@ -870,7 +950,6 @@ namespace FieldNames
 		static const char* X		= "x";
 		static const char* Y		= "y";
 		static const char* Z		= "z";
-		static const char* Units	= "units";
 	}
 	
 	namespace Material
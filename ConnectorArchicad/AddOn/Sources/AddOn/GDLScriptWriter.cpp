@@ -0,0 +1,154 @@
+#include "GDLScriptWriter.hpp"
+
+#include "APIMigrationHelper.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+
+static void AppendUnsigned (std::string& buffer, GS::UInt64 value)
+{
+	char digits[24];
+	char* end = digits + sizeof (digits);
+	char* begin = end;
+
+	do {
+		*--begin = static_cast<char> ('0' + value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	buffer.append (begin, end - begin);
+}
+
+
+static void AppendSigned (std::string& buffer, GS::Int64 value)
+{
+	if (value < 0) {
+		buffer += '-';
+		AppendUnsigned (buffer, GS::UInt64 (0) - GS::UInt64 (value));
+	} else {
+		AppendUnsigned (buffer, GS::UInt64 (value));
+	}
+}
+
+
+GDLScriptWriter::GDLScriptWriter (size_t chunkSize /*= DefaultChunkSize*/) :
+	chunkSize (chunkSize),
+	lastError (NoError)
+{
+	buffer.reserve (chunkSize + 1024);
+}
+
+
+GDLScriptWriter::~GDLScriptWriter ()
+{
+	Flush ();
+}
+
+
+GDLScriptWriter& GDLScriptWriter::operator<< (const char* text)
+{
+	buffer.append (text);
+	FlushIfFull ();
+
+	return *this;
+}
+
+
+GDLScriptWriter& GDLScriptWriter::operator<< (const GS::String& text)
+{
+	buffer.append (text.ToCStr (), text.GetLength ());
+	FlushIfFull ();
+
+	return *this;
+}
+
+
+GDLScriptWriter& GDLScriptWriter::operator<< (char character)
+{
+	buffer += character;
+	FlushIfFull ();
+
+	return *this;
+}
+
+
+GDLScriptWriter& GDLScriptWriter::operator<< (Int32 value)
+{
+	AppendSigned (buffer, value);
+	FlushIfFull ();
+
+	return *this;
+}
+
+
+GDLScriptWriter& GDLScriptWriter::operator<< (UInt32 value)
+{
+	AppendUnsigned (buffer, value);
+	FlushIfFull ();
+
+	return *this;
+}
+
+
+GDLScriptWriter& GDLScriptWriter::operator<< (double value)
+{
+	AppendDouble (buffer, value);
+	FlushIfFull ();
+
+	return *this;
+}
+
+
+GSErrCode GDLScriptWriter::Flush ()
+{
+	if (!buffer.empty ()) {
+		GSErrCode err = ACAPI_LibraryPart_WriteSection ((Int32) buffer.size (), buffer.c_str ());
+		if (err != NoError && lastError == NoError)
+			lastError = err;
+
+		buffer.clear ();
+	}
+
+	return lastError;
+}
+
+
+void GDLScriptWriter::FlushIfFull ()
+{
+	if (buffer.size () >= chunkSize)
+		Flush ();
+}
+
+
+/*!
+ Append a decimal representation of a value that reads back to the same double
+ The output is independent of the current locale, very small and very large values are written in the exponent notation
+ @param buffer The target buffer
+ @param value The value to append
+ */
+void GDLScriptWriter::AppendDouble (std::string& buffer, double value)
+{
+	if (!std::isfinite (value)) {
+		buffer += '0';
+		return;
+	}
+
+	// integral coordinates are common, they don't need the floating point formatter at all
+	if (value == std::floor (value) && std::fabs (value) < 1e15) {
+		AppendSigned (buffer, static_cast<GS::Int64> (value));
+		return;
+	}
+
+	// 17 significant digits always read back to the same double
+	char text[32];
+	int length = snprintf (text, sizeof (text), "%.17g", value);
+
+	// the decimal separator of the current locale
+	for (int i = 0; i < length; ++i) {
+		if (text[i] == ',')
+			text[i] = '.';
+	}
+
+	buffer.append (text, length);
+}
@@ -0,0 +1,44 @@
+#ifndef GDL_SCRIPT_WRITER_HPP
+#define GDL_SCRIPT_WRITER_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+
+#include <string>
+
+
+/*!
+ Buffered writer for the currently open library part section.
+ Text is collected in a single growable buffer and handed over to ACAPI_LibraryPart_WriteSection in large chunks,
+ numbers are formatted without the locale and without going through GS::String::SPrintf.
+ */
+class GDLScriptWriter {
+public:
+	static const size_t DefaultChunkSize = 256 * 1024;
+
+	GDLScriptWriter (size_t chunkSize = DefaultChunkSize);
+	~GDLScriptWriter ();
+
+	GDLScriptWriter (const GDLScriptWriter&) = delete;
+	void operator= (const GDLScriptWriter&) = delete;
+
+	GDLScriptWriter&	operator<< (const char* text);
+	GDLScriptWriter&	operator<< (const GS::String& text);
+	GDLScriptWriter&	operator<< (char character);
+	GDLScriptWriter&	operator<< (Int32 value);
+	GDLScriptWriter&	operator<< (UInt32 value);
+	GDLScriptWriter&	operator<< (double value);
+
+	GSErrCode			Flush ();
+
+	static void			AppendDouble (std::string& buffer, double value);
+
+private:
+	void				FlushIfFull ();
+
+	std::string			buffer;
+	size_t				chunkSize;
+	GSErrCode			lastError;
+};
+
+#endif
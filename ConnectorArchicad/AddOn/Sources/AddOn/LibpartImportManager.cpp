@@ -2,12 +2,21 @@
 
 #include "APIMigrationHelper.hpp"
 #include "BuiltInLibrary.hpp"
+#include "File.hpp"
 #include "FileSystem.hpp"
 #include "Folder.hpp"
 #include "GSUnID.hpp"
 #include "MD5Channel.hpp"
 #include "AttributeManager.hpp"
 #include "Box3DData.h"
+#include "GDLScriptWriter.hpp"
+#include "PerformanceStats.hpp"
+
+
+// bump it when the generated scripts change, so the parts of the previous versions are not reused
+static const char* LibraryPartGeneratorVersion = "Speckle Object 2";
+static const char* LibraryFolderName = "Speckle Library";
+static const char* LibraryIndexFileName = "SpeckleLibraryIndex.txt";
 
 
 LibpartImportManager* LibpartImportManager::instance = nullptr;
@@ -21,6 +30,12 @@ LibpartImportManager* LibpartImportManager::GetInstance ()
 }
 
 
+bool LibpartImportManager::HasInstance ()
+{
+	return nullptr != instance;
+}
+
+
 void LibpartImportManager::DeleteInstance ()
 {
 	if (nullptr != instance) {
@@ -30,61 +45,86 @@ void LibpartImportManager::DeleteInstance ()
 }
 
 
-LibpartImportManager::LibpartImportManager () : runningNumber (1)
+LibpartImportManager::LibpartImportManager () : libraryIndexChanged (false)
 {
 	AttributeManager::GetInstance ()->GetDefaultMaterial (defaultMaterialAttribute, defaultMaterialName);
 	GetLocation (true, libraryFolderLocation);
+	LoadLibraryIndex ();
 }
 
 
 LibpartImportManager::~LibpartImportManager ()
 {
+	SaveLibraryIndex ();
+
 	if (libraryFolderLocation != nullptr)
 		delete libraryFolderLocation;
 }
 
 
-static GSErrCode CreateSubFolder (const GS::UniString& name, IO::Location& location)
+static GSErrCode GetOrCreateSubFolder (const GS::UniString& name, IO::Location& location)
 {
 	GSErrCode err = NoError;
 
 	if (location.IsEmpty () || name.IsEmpty ())
 		return err;
 
-	GSTimeRecord gsTimeRecord;
-	GSTime gsTime (0);
-
-	TIGetTimeRecord (gsTime, &gsTimeRecord, TI_CURRENT_TIME);
-	GS::UniString folderNamePostfix (GS::UniString::SPrintf ("%04u%02u%02u-%02u%02u%02u",
-		(UInt32) gsTimeRecord.year, (UInt32) gsTimeRecord.month, (UInt32) gsTimeRecord.day,
-		(UInt32) gsTimeRecord.hour, (UInt32) gsTimeRecord.minute, (UInt32) gsTimeRecord.second));
-
 	IO::Name folderName (name);
-	folderName.Append ("_");
-	folderName.Append (folderNamePostfix);
+	IO::Location folderLocation (location);
+	folderLocation.AppendToLocal (folderName);
 
-	IO::Folder folder (location);
-	err = folder.CreateFolder (folderName);
+	bool exist = false;
+	err = IO::fileSystem.Contains (folderLocation, &exist);
 	if (err != NoError)
 		return err;
 
-	location.AppendToLocal (folderName);
+	if (!exist) {
+		IO::Folder folder (location);
+		err = folder.CreateFolder (folderName);
+		if (err != NoError)
+			return err;
+	}
+
+	location = folderLocation;
 
 	return err;
 }
 
 
+static GS::UniString GetLibraryPartName (GS::UInt64 contentHash)
+{
+	return GS::UniString::SPrintf ("Speckle Object %08X%08X", (UInt32) (contentHash >> 32), (UInt32) (contentHash & 0xFFFFFFFF));
+}
+
 
 GSErrCode LibpartImportManager::GetLibpartFromCache (const GS::Array<GS::UniString> modelIds,
 	API_LibPart& libPart)
 {
-	GS::UInt64 checksum = GenerateFingerPrint (modelIds);
-	GSErrCode err = Error;
-	if (cache.Get (checksum, &libPart)) {
-		err = NoError;
-	}
+	GS::UInt64 contentHash = 0;
+	if (!modelIdsToContent.Get (GenerateFingerPrint (modelIds), &contentHash))
+		return Error;
 
-	return err;
+	return cache.Get (contentHash, &libPart) ? NoError : Error;
+}
+
+
+// the materials the 3D script of a part refers to by name, the unreferenced materials of the model are not created
+static void CreateReferencedMaterials (const ModelInfo& modelInfo, AttributeManager& attributeManager)
+{
+	GS::HashSet<Int32> createdMaterials;
+	for (const auto& polygon : modelInfo.GetPolygons ()) {
+		const Int32 materialIndex = polygon.GetMaterial ();
+		if (createdMaterials.Contains (materialIndex))
+			continue;
+
+		createdMaterials.Add (materialIndex);
+
+		ModelInfo::Material material;
+		if (NoError == modelInfo.GetMaterial (static_cast<UInt32> (materialIndex), material)) {
+			API_Attribute materialAttribute;
+			attributeManager.GetMaterial (material, materialAttribute);
+		}
+	}
 }
 
 
@@ -92,24 +132,131 @@ GSErrCode LibpartImportManager::GetLibpart (const ModelInfo& modelInfo,
 	AttributeManager& attributeManager,
 	API_LibPart& libPart)
 {
-	GS::UInt64 checksum = GenerateFingerPrint (modelInfo.GetIds ());
-	GSErrCode err = Error;
-	if (cache.Get (checksum, &libPart)) {
-		err = NoError;
-	} else {
-		err = CreateLibraryPart (modelInfo, attributeManager, libPart);
-		if (err == NoError)
-			cache.Add (checksum, libPart);
+	GS::UInt64 contentHash = GenerateContentFingerPrint (modelInfo);
+	GSErrCode err = NoError;
+	if (!cache.Get (contentHash, &libPart)) {
+		GS::UniString libPartName = GetLibraryPartName (contentHash);
+
+		// the materials are created the first time a part is used in this transaction, later uses of the part find them
+		CreateReferencedMaterials (modelInfo, attributeManager);
+
+		// identical geometry received earlier, in this or in a previous transaction
+		err = FindLibraryPart (libPartName, libPart);
+		if (err != NoError)
+			err = CreateLibraryPart (modelInfo, libPartName, libPart);
+
+		if (err != NoError)
+			return err;
+
+		cache.Add (contentHash, libPart);
+		if (!libraryIndex.Contains (contentHash)) {
+			libraryIndex.Add (contentHash);
+			libraryIndexChanged = true;
+		}
 	}
 
+	modelIdsToContent.Put (GenerateFingerPrint (modelInfo.GetIds ()), contentHash);
+
 	return err;
 }
 
 
+GSErrCode LibpartImportManager::FindLibraryPart (const GS::UniString& libPartName, API_LibPart& libPart) const
+{
+	BNZeroMemory (&libPart, sizeof (API_LibPart));
+	libPart.typeID = APILib_ObjectID;
+	GS::ucscpy (libPart.docu_UName, libPartName.ToUStr ());
+
+	GSErrCode err = ACAPI_LibraryPart_Search (&libPart, false, true);
+	if (err != NoError)
+		return err;
+
+	// the file could have been removed since the library was loaded
+	bool exist = false;
+	if (libPart.location != nullptr) {
+		IO::fileSystem.Contains (*libPart.location, &exist);
+		delete libPart.location;
+		libPart.location = nullptr;
+	}
+
+	return exist && libPart.index > 0 ? NoError : APIERR_BADNAME;
+}
+
+
+/*!
+ Delete the generated library parts no placed object uses from the embedded library, then reload the libraries
+ Run by the connector when a receive has finished (see the RemoveUnusedLibraryParts command), never inside one: the parts of the objects replaced by a receive are unused only once it is done
+ @return NoError if the unused parts were removed
+ */
+GSErrCode LibpartImportManager::RemoveUnusedLibraryParts ()
+{
+	if (libraryFolderLocation == nullptr || libraryIndex.IsEmpty ())
+		return NoError;
+
+	GS::Array<API_Guid> elementGuids;
+	GSErrCode err = ACAPI_Element_GetElemList (API_ObjectID, &elementGuids);
+	if (err != NoError)
+		return err;
+
+	GS::HashSet<Int32> usedLibraryParts;
+	for (const API_Guid& guid : elementGuids) {
+		API_Element element;
+		BNZeroMemory (&element, sizeof (API_Element));
+		element.header.guid = guid;
+		if (ACAPI_Element_Get (&element) == NoError)
+			usedLibraryParts.Add (element.object.libInd);
+	}
+
+	GS::Array<GS::UInt64> unusedParts;
+	bool deletedParts = false;
+	for (GS::UInt64 contentHash : libraryIndex) {
+		API_LibPart libPart;
+		BNZeroMemory (&libPart, sizeof (API_LibPart));
+		libPart.typeID = APILib_ObjectID;
+		GS::ucscpy (libPart.docu_UName, GetLibraryPartName (contentHash).ToUStr ());
+
+		if (ACAPI_LibraryPart_Search (&libPart, false, true) != NoError) {
+			// not in the loaded library any more, forget about it
+			unusedParts.Push (contentHash);
+			continue;
+		}
+
+		if (!usedLibraryParts.Contains (libPart.index)) {
+				// through the library manager, so the loaded library knows about it
+			if (libPart.location != nullptr && ACAPI_LibraryManagement_DeleteEmbeddedLibItem (libPart.location, false, true) == NoError)
+				deletedParts = true;
+			unusedParts.Push (contentHash);
+		}
+
+		if (libPart.location != nullptr)
+			delete libPart.location;
+	}
+
+	for (GS::UInt64 contentHash : unusedParts) {
+		libraryIndex.Delete (contentHash);
+		cache.Delete (contentHash);
+	}
+
+	if (!unusedParts.IsEmpty ())
+		libraryIndexChanged = true;
+
+	if (deletedParts) {
+		err = ACAPI_ProjectOperation_ReloadLibraries ();
+		if (err != NoError)
+			return err;
+	}
+
+	return SaveLibraryIndex ();
+}
+
+
 GSErrCode LibpartImportManager::CreateLibraryPart (const ModelInfo& modelInfo,
-	AttributeManager& attributeManager,
+	const GS::UniString& libPartName,
 	API_LibPart& libPart)
 {
+	static PerformanceStats::Counter& gdlCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::GDLWriting);
+	PerformanceStats::ScopedTimer timer (gdlCounter);
+
 	GSErrCode err = NoError;
 	BNZeroMemory (&libPart, sizeof (API_LibPart));
 	libPart.typeID = APILib_ObjectID;
@@ -121,7 +268,7 @@ GSErrCode LibpartImportManager::CreateLibraryPart (const ModelInfo& modelInfo,
 	const GS::UnID unID = BL::BuiltInLibraryMainGuidContainer::GetInstance ().GetUnIDWithNullRevGuid (BL::BuiltInLibPartID::BuildingElementLibPartID);
 	CHCopyC (unID.ToUniString ().ToCStr (), libPart.parentUnID);
 
-	GS::ucscpy (libPart.docu_UName, GS::UniString::SPrintf ("Speckle Object %u", runningNumber++).ToUStr ());
+	GS::ucscpy (libPart.docu_UName, libPartName.ToUStr ());
 
 	ACAPI_LibraryManagement_OverwriteLibPart ((void*) (Int32) true);
 	err = ACAPI_LibraryPart_Create (&libPart);
@@ -169,155 +316,133 @@ GSErrCode LibpartImportManager::CreateLibraryPart (const ModelInfo& modelInfo,
 		section.sectType = API_Sect3DScript;
 		ACAPI_LibraryPart_NewSection (&section);
 
-		line = GS::String::SPrintf ("!%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("! 3D Script (Generated by Speckle Connector)%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("!%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+		{
+			GDLScriptWriter script;
+
+			script << "!" << GS::EOL;
+			script << "! 3D Script (Generated by Speckle Connector)" << GS::EOL;
+			script << "!" << GS::EOL << GS::EOL;
+
+			script << "defaultResolution = 36" << GS::EOL;
+			script << "RESOL defaultResolution" << GS::EOL << GS::EOL;
+
+			script << "hiddenProfileEdge = 0" << GS::EOL;
+			script << "hiddenBodyEdge = 0" << GS::EOL;
+			script << "smoothBodyEdge = 0" << GS::EOL;
+			script << "visibleBodyEdge = 262144" << GS::EOL << GS::EOL;
+
+			script << "IF (GLOB_CONTEXT % 10 >= 2 AND GLOB_CONTEXT % 10 <= 4) AND showOnlyContourEdgesIn3D <> 0 THEN" << GS::EOL;
+			script << "\thiddenProfileEdge = 1" << GS::EOL;
+			script << "\thiddenBodyEdge = 1" << GS::EOL;
+			script << "\tsmoothBodyEdge = 2" << GS::EOL;
+			script << "ENDIF" << GS::EOL << GS::EOL;
+
+			script << "!" << GS::EOL << GS::EOL;
+			script << "RESOL defaultResolution" << GS::EOL << GS::EOL;
+			script << "XFORM map_xform[1][1], map_xform[2][1], map_xform[3][1], map_xform[4][1]," << GS::EOL;
+			script << "\tmap_xform[1][2], map_xform[2][2], map_xform[3][2], map_xform[4][2]," << GS::EOL;
+			script << "\tmap_xform[1][3], map_xform[2][3], map_xform[3][3], map_xform[4][3]" << GS::EOL << GS::EOL;
+
+			const GS::Array<ModelInfo::Vertex>& vertices = modelInfo.GetVertices ();
+			Box3D box = Box3D::CreateEmpty ();
+			for (UInt32 i = 0; i < vertices.GetSize (); i++) {
+				script << "VERT " << vertices[i].GetX () << ", " << vertices[i].GetY () << ", " << vertices[i].GetZ () << "\t!#" << i + 1 << GS::EOL;
+				box.Extend (Point3D (vertices[i].GetX (), vertices[i].GetY (), vertices[i].GetZ ()));
+			}
 
-		line = GS::String::SPrintf ("defaultResolution = 36%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("RESOL defaultResolution%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+			script << GS::EOL;
 
-		line = GS::String::SPrintf ("hiddenProfileEdge = 0%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("hiddenBodyEdge = 0%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("smoothBodyEdge = 0%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("visibleBodyEdge = 262144%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-
-		line = GS::String::SPrintf ("IF (GLOB_CONTEXT %% 10 >= 2 AND GLOB_CONTEXT %% 10 <= 4) AND showOnlyContourEdgesIn3D <> 0 THEN%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("\thiddenProfileEdge = 1%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("\thiddenBodyEdge = 1%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("\tsmoothBodyEdge = 2%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("ENDIF%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+			const GS::HashTable<ModelInfo::EdgeId, ModelInfo::EdgeData>& edges = modelInfo.GetEdges ();
 
-		line = GS::String::SPrintf ("!%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("RESOL defaultResolution%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("XFORM map_xform[1][1], map_xform[2][1], map_xform[3][1], map_xform[4][1],%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("\tmap_xform[1][2], map_xform[2][2], map_xform[3][2], map_xform[4][2],%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("\tmap_xform[1][3], map_xform[2][3], map_xform[3][3], map_xform[4][3]%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+			// edges shared by neighbouring polygons are written once, the polygons refer to them with a signed index
+			GS::HashTable<ModelInfo::EdgeId, GS::Pair<UInt32, Int32>> writtenEdges;
 
-		// create material
-		GS::Array<ModelInfo::Material> materials = modelInfo.GetMaterials ();
-		for (const auto& material : materials) {
-			API_Attribute materialAttribute;
-			attributeManager.GetMaterial (material, materialAttribute);
-		}
+			UInt32 edgeIndex = 1;
+			UInt32 polygonIndex = 1;
+			GS::Array<Int32> polygonEdges;
+			const GS::Array<ModelInfo::Polygon>& polygons = modelInfo.GetPolygons ();
+			for (const auto& polygon : polygons) {
+				const GS::Array<Int32>& pointIds = polygon.GetPointIds ();
+				UInt32 pointsCount = pointIds.GetSize ();
 
-		GS::Array<ModelInfo::Vertex> vertices = modelInfo.GetVertices ();
-		Box3D box = Box3D::CreateEmpty ();
-		for (UInt32 i = 0; i < vertices.GetSize (); i++) {
-			line = GS::String::SPrintf ("VERT %f, %f, %f\t!#%u%s", (float)vertices[i].GetX (), (float)vertices[i].GetY (), (float)vertices[i].GetZ (), i + 1, GS::EOL);
-			ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-			box.Extend (Point3D (vertices[i].GetX (), vertices[i].GetY (), vertices[i].GetZ ()));
-		}
+				GS::UniString materialName = defaultMaterialName;
+				{
+					ModelInfo::Material material;
+					if (NoError == modelInfo.GetMaterial (polygon.GetMaterial (), material)) {
+						materialName = material.GetName ();
+					}
+				}
 
-		line = GS::String::SPrintf ("%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+				script << "! Polygon #" << polygonIndex << GS::EOL << GS::EOL << "MATERIAL \"" << materialName.ToCStr ().Get () << "\"" << GS::EOL;
 
-		const GS::HashTable<ModelInfo::EdgeId, ModelInfo::EdgeData>& edges = modelInfo.GetEdges ();
+				polygonEdges.Clear ();
+				for (UInt32 i = 0; i < pointsCount; i++) {
+					Int32 start = i;
+					Int32 end = i == pointIds.GetSize () - 1 ? 0 : i + 1;
 
-		UInt32 edgeIndex = 1;
-		UInt32 polygonIndex = 1;
-		GS::Array<ModelInfo::Polygon> polygons = modelInfo.GetPolygons ();
-		for (const auto& polygon : polygons) {
-			const GS::Array<Int32>& pointIds = polygon.GetPointIds ();
-			UInt32 pointsCount = pointIds.GetSize ();
+					Int32 startPointId = pointIds[start], endPointId = pointIds[end];
+					ModelInfo::EdgeId edge (startPointId, endPointId);
 
-			GS::UniString materialName = defaultMaterialName;
-			{
-				ModelInfo::Material material;
-				if (NoError == modelInfo.GetMaterial (polygon.GetMaterial (), material)) {
-					materialName = material.GetName ();
-				}
-			}
+					// the written edge and the start point it was written with
+					const GS::Pair<UInt32, Int32>* writtenEdge = writtenEdges.GetPtr (edge);
+					if (writtenEdge != nullptr) {
+						Int32 writtenEdgeIndex = (Int32) writtenEdge->first;
+						polygonEdges.Push (writtenEdge->second == startPointId ? writtenEdgeIndex : -writtenEdgeIndex);
+						continue;
+					}
 
-			line = GS::String::SPrintf ("! Polygon #%u%s%sMATERIAL \"%s\"%s", polygonIndex, GS::EOL, GS::EOL, materialName.ToCStr ().Get (), GS::EOL);
-			ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-
-			for (UInt32 i = 0; i < pointsCount; i++) {
-				Int32 start = i;
-				Int32 end = i == pointIds.GetSize () - 1 ? 0 : i + 1;
-
-				Int32 startPointId = pointIds[start], endPointId = pointIds[end];
-				ModelInfo::EdgeId edge (startPointId, endPointId);
-
-				bool smooth = false;
-				bool hidden = true;
-				if (edges.ContainsKey (edge)) {
-					ModelInfo::EdgeData edgeData = edges.Get (edge);
-
-					switch (edgeData.edgeStatus) {
-					case ModelInfo::HiddenEdge:
-						break;
-					case ModelInfo::SmoothEdge:
-						hidden = false;
-						smooth = true;
-						break;
-					case ModelInfo::VisibleEdge:
-						hidden = false;
-						break;
-					default:
-						break;
+					bool smooth = false;
+					bool hidden = true;
+					const ModelInfo::EdgeData* edgeData = edges.GetPtr (edge);
+					if (edgeData != nullptr) {
+						switch (edgeData->edgeStatus) {
+						case ModelInfo::HiddenEdge:
+							break;
+						case ModelInfo::SmoothEdge:
+							hidden = false;
+							smooth = true;
+							break;
+						case ModelInfo::VisibleEdge:
+							hidden = false;
+							break;
+						default:
+							break;
+						}
 					}
+
+					script << "EDGE " << startPointId + 1 << ", " << endPointId + 1 << ", -1, -1, " << (smooth ? "smoothBodyEdge" : (hidden ? "hiddenBodyEdge" : "visibleBodyEdge")) << "\t!#" << edgeIndex << GS::EOL;
+
+					writtenEdges.Add (edge, GS::Pair<UInt32, Int32> (edgeIndex, startPointId));
+					polygonEdges.Push ((Int32) edgeIndex);
+					edgeIndex++;
 				}
 
-				line = GS::String::SPrintf ("EDGE %d, %d, -1, -1, %s\t!#%u%s", pointIds[start] + 1, pointIds[end] + 1, (smooth ? "smoothBodyEdge" : (hidden ? "hiddenBodyEdge" : "visibleBodyEdge")), edgeIndex + i, GS::EOL);
-				ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-			}
+				script << "PGON " << pointsCount << ", 0, -1";
 
-			line = GS::String::SPrintf ("PGON %u, 0, -1", pointsCount);
-			ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+				for (UInt32 i = 0; i < polygonEdges.GetSize (); i++) {
+					script << "," << ((i + 1) % 10 == 0 ? GS::EOL : " ") << polygonEdges[i];
+				}
+
+				script << "\t!#" << polygonIndex << GS::EOL << GS::EOL;
 
-			for (UInt32 i = 0; i < pointsCount; i++) {
-				line = GS::String::SPrintf (",%s%u", ((i + 1) % 10 == 0 ? GS::EOL : " "), edgeIndex + i);
-				ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+				polygonIndex++;
 			}
 
-			line = GS::String::SPrintf ("\t!#%u%s%s", polygonIndex, GS::EOL, GS::EOL);
-			ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+			script << "BODY 4" << GS::EOL << GS::EOL;
 
-			edgeIndex += pointsCount;
-			polygonIndex++;
-		}
-
-		line = GS::String::SPrintf ("BODY 4%s%s", GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+			script << "HOTSPOT " << box.GetMinX () << ", " << box.GetMinY () << ", " << box.GetMinZ () << GS::EOL;
+			script << "HOTSPOT " << box.GetMinX () << ", " << box.GetMinY () << ", " << box.GetMaxZ () << GS::EOL;
+			script << "HOTSPOT " << box.GetMinX () << ", " << box.GetMaxY () << ", " << box.GetMinZ () << GS::EOL;
+			script << "HOTSPOT " << box.GetMinX () << ", " << box.GetMaxY () << ", " << box.GetMaxZ () << GS::EOL;
+			script << "HOTSPOT " << box.GetMaxX () << ", " << box.GetMinY () << ", " << box.GetMinZ () << GS::EOL;
+			script << "HOTSPOT " << box.GetMaxX () << ", " << box.GetMinY () << ", " << box.GetMaxZ () << GS::EOL;
+			script << "HOTSPOT " << box.GetMaxX () << ", " << box.GetMaxY () << ", " << box.GetMinZ () << GS::EOL;
+			script << "HOTSPOT " << box.GetMaxX () << ", " << box.GetMaxY () << ", " << box.GetMaxZ () << GS::EOL << GS::EOL;
 
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s", (float)box.GetMinX (), (float)box.GetMinY (), (float)box.GetMinZ (), GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s", (float)box.GetMinX (), (float)box.GetMinY (), (float)box.GetMaxZ (), GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s", (float)box.GetMinX (), (float)box.GetMaxY (), (float)box.GetMinZ (), GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s", (float)box.GetMinX (), (float)box.GetMaxY (), (float)box.GetMaxZ (), GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s", (float)box.GetMaxX (), (float)box.GetMinY (), (float)box.GetMinZ (), GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s", (float)box.GetMaxX (), (float)box.GetMinY (), (float)box.GetMaxZ (), GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s", (float)box.GetMaxX (), (float)box.GetMaxY (), (float)box.GetMinZ (), GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("HOTSPOT %f, %f, %f%s%s", (float)box.GetMaxX (), (float)box.GetMaxY (), (float)box.GetMaxZ (), GS::EOL, GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+			script << "DEL TOP";
 
-		line = "DEL TOP";
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+			err = script.Flush ();
+		}
 
 		ACAPI_LibraryPart_EndSection ();
 
@@ -325,18 +450,17 @@ GSErrCode LibpartImportManager::CreateLibraryPart (const ModelInfo& modelInfo,
 		BNZeroMemory (&section, sizeof (API_LibPartSection));
 		section.sectType = API_Sect2DScript;
 		ACAPI_LibraryPart_NewSection (&section);
-		line = GS::String::SPrintf ("!%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("! 2D Script (Generated by Speckle Connector)%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("!%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("PEN gs_cont_pen%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("SET FILL gs_fill_type%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
-		line = GS::String::SPrintf ("PROJECT2{2} 3, 270.0, 3+32, gs_back_pen, 0, 0, 0%s", GS::EOL);
-		ACAPI_LibraryPart_WriteSection (line.GetLength (), line.ToCStr ());
+		{
+			GDLScriptWriter script;
+			script << "!" << GS::EOL;
+			script << "! 2D Script (Generated by Speckle Connector)" << GS::EOL;
+			script << "!" << GS::EOL;
+			script << "PEN gs_cont_pen" << GS::EOL;
+			script << "SET FILL gs_fill_type" << GS::EOL;
+			script << "PROJECT2{2} 3, 270.0, 3+32, gs_back_pen, 0, 0, 0" << GS::EOL;
+			if (err == NoError)
+				err = script.Flush ();
+		}
 		ACAPI_LibraryPart_EndSection ();
 
 		// Parameter script section
@@ -423,7 +547,7 @@ GSErrCode LibpartImportManager::GetLocation (bool useEmbeddedLibrary, IO::Locati
 			}
 
 			if (libraryFolderLocation != nullptr) {
-				CreateSubFolder ("Speckle Library", *libraryFolderLocation);
+				GetOrCreateSubFolder (LibraryFolderName, *libraryFolderLocation);
 			}
 		}
 	} else {
@@ -432,7 +556,7 @@ GSErrCode LibpartImportManager::GetLocation (bool useEmbeddedLibrary, IO::Locati
 			IO::Location folderLoc;
 			API_SpecFolderID specID = API_UserDocumentsFolderID;
 			ACAPI_ProjectSettings_GetSpecFolder (&specID, &folderLoc);
-			folderLoc.AppendToLocal (IO::Name ("Speckle Library"));
+			folderLoc.AppendToLocal (IO::Name (LibraryFolderName));
 			IO::Folder destFolder (folderLoc, IO::Folder::Create);
 			if (destFolder.GetStatus () != NoError || !destFolder.IsWriteable ())
 				return APIERR_GENERAL;
@@ -473,3 +597,136 @@ GS::UInt64 LibpartImportManager::GenerateFingerPrint (const GS::Array<GS::UniStr
 	md5Channel.Finish (&checkSum);
 	return checkSum.GetUInt64Value ();
 }
+
+
+GS::UInt64 LibpartImportManager::GenerateContentFingerPrint (const ModelInfo& modelInfo) const
+{
+	IO::MD5Channel md5Channel;
+	MD5::FingerPrint checkSum;
+
+	md5Channel.Write (GS::UniString (LibraryPartGeneratorVersion));
+
+	const GS::Array<ModelInfo::Vertex>& vertices = modelInfo.GetVertices ();
+	md5Channel.Write (vertices.GetSize ());
+	for (const auto& vertex : vertices) {
+		md5Channel.Write (vertex.GetX ());
+		md5Channel.Write (vertex.GetY ());
+		md5Channel.Write (vertex.GetZ ());
+	}
+
+	const GS::HashTable<ModelInfo::EdgeId, ModelInfo::EdgeData>& edges = modelInfo.GetEdges ();
+	const GS::Array<ModelInfo::Polygon>& polygons = modelInfo.GetPolygons ();
+	md5Channel.Write (polygons.GetSize ());
+	for (const auto& polygon : polygons) {
+		const GS::Array<Int32>& pointIds = polygon.GetPointIds ();
+		md5Channel.Write (pointIds.GetSize ());
+		for (UInt32 i = 0; i < pointIds.GetSize (); i++) {
+			Int32 endPointId = pointIds[i == pointIds.GetSize () - 1 ? 0 : i + 1];
+			const ModelInfo::EdgeData* edgeData = edges.GetPtr (ModelInfo::EdgeId (pointIds[i], endPointId));
+
+			md5Channel.Write (pointIds[i]);
+			md5Channel.Write (edgeData != nullptr ? (Int32) edgeData->edgeStatus : 0);
+		}
+
+		// the material is hashed by its content, the index could refer to anything in another model
+		ModelInfo::Material material;
+		if (NoError == modelInfo.GetMaterial (polygon.GetMaterial (), material)) {
+			md5Channel.Write (material.GetName ());
+			md5Channel.Write (material.GetTransparency ());
+			md5Channel.Write (material.GetAmbientColor ().red);
+			md5Channel.Write (material.GetAmbientColor ().green);
+			md5Channel.Write (material.GetAmbientColor ().blue);
+			md5Channel.Write (material.GetEmissionColor ().red);
+			md5Channel.Write (material.GetEmissionColor ().green);
+			md5Channel.Write (material.GetEmissionColor ().blue);
+		} else {
+			md5Channel.Write (defaultMaterialName);
+		}
+	}
+
+	md5Channel.Finish (&checkSum);
+	return checkSum.GetUInt64Value ();
+}
+
+
+GSErrCode LibpartImportManager::LoadLibraryIndex ()
+{
+	libraryIndex.Clear ();
+	libraryIndexChanged = false;
+
+	if (libraryFolderLocation == nullptr)
+		return Error;
+
+	IO::Location indexLocation (*libraryFolderLocation);
+	indexLocation.AppendToLocal (IO::Name (LibraryIndexFileName));
+
+	IO::File indexFile (indexLocation, IO::File::Fail);
+	if (indexFile.GetStatus () != NoError)
+		return NoError;	// no parts created yet
+
+	GSErrCode err = indexFile.Open (IO::File::ReadMode);
+	if (err != NoError)
+		return err;
+
+	UInt64 dataLength = 0;
+	err = indexFile.GetDataLength (&dataLength);
+	if (err == NoError && dataLength > 0) {
+		GS::Array<char> data ((USize) dataLength, '\0');
+		err = indexFile.ReadBin (data.GetContent (), (USize) dataLength);
+
+		// one hexadecimal content hash per line
+		GS::UInt64 contentHash = 0;
+		UInt32 digits = 0;
+		for (UInt32 i = 0; err == NoError && i <= data.GetSize (); i++) {
+			char c = i < data.GetSize () ? data[i] : '\n';
+			if (c >= '0' && c <= '9') {
+				contentHash = (contentHash << 4) | (GS::UInt64) (c - '0');
+				digits++;
+			} else if (c >= 'A' && c <= 'F') {
+				contentHash = (contentHash << 4) | (GS::UInt64) (c - 'A' + 10);
+				digits++;
+			} else if (c >= 'a' && c <= 'f') {
+				contentHash = (contentHash << 4) | (GS::UInt64) (c - 'a' + 10);
+				digits++;
+			} else {
+				if (digits == 16)
+					libraryIndex.Add (contentHash);
+				contentHash = 0;
+				digits = 0;
+			}
+		}
+	}
+
+	indexFile.Close ();
+
+	return err;
+}
+
+
+GSErrCode LibpartImportManager::SaveLibraryIndex ()
+{
+	if (!libraryIndexChanged || libraryFolderLocation == nullptr)
+		return NoError;
+
+	IO::Location indexLocation (*libraryFolderLocation);
+	indexLocation.AppendToLocal (IO::Name (LibraryIndexFileName));
+
+	IO::File indexFile (indexLocation, IO::File::Create);
+	GSErrCode err = indexFile.GetStatus ();
+	if (err == NoError)
+		err = indexFile.Open (IO::File::WriteEmptyMode);
+	if (err != NoError)
+		return err;
+
+	GS::String data;
+	for (GS::UInt64 contentHash : libraryIndex)
+		data.Append (GS::String::SPrintf ("%08X%08X\n", (UInt32) (contentHash >> 32), (UInt32) (contentHash & 0xFFFFFFFF)));
+
+	err = indexFile.WriteBin (data.ToCStr (), data.GetLength ());
+	indexFile.Close ();
+
+	if (err == NoError)
+		libraryIndexChanged = false;
+
+	return err;
+}
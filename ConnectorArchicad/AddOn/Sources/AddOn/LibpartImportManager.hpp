@@ -9,31 +9,45 @@ class LibpartImportManager {
 private:
 	static LibpartImportManager*			instance;
 	IO::Location*							libraryFolderLocation;
+
+		///Library parts keyed by the hash of their geometry and material content
 	GS::HashTable<GS::UInt64, API_LibPart>	cache;
+		///Content hashes keyed by the fingerprint of the Speckle ids of the models they were created from
+	GS::HashTable<GS::UInt64, GS::UInt64>	modelIdsToContent;
+		///Content hashes of the library parts in the Speckle library folder, persisted next to the parts
+	GS::HashSet<GS::UInt64>					libraryIndex;
+	bool									libraryIndexChanged;
 
 	API_Attribute							defaultMaterialAttribute;
 	GS::UniString							defaultMaterialName;
-	UInt32									runningNumber;
 
 protected:
 	LibpartImportManager ();
 
 public:
 	~LibpartImportManager ();
-	
+
 	LibpartImportManager (LibpartImportManager&) = delete;
 	void		operator=(const LibpartImportManager&) = delete;
 	static LibpartImportManager*	GetInstance ();
+	static bool						HasInstance ();
 	static void						DeleteInstance ();
 
 	GSErrCode	GetLibpart (const ModelInfo& modelInfo, AttributeManager& attributeManager, API_LibPart& libPart);
 
 	GSErrCode GetLibpartFromCache(const GS::Array<GS::UniString> modelIds, API_LibPart& libPart);
 
+	GSErrCode	RemoveUnusedLibraryParts ();
+
 private:
-	GSErrCode	CreateLibraryPart (const ModelInfo& modelInfo, AttributeManager& attributeManager, API_LibPart& libPart);
+	GSErrCode	CreateLibraryPart (const ModelInfo& modelInfo, const GS::UniString& libPartName, API_LibPart& libPart);
+	GSErrCode	FindLibraryPart (const GS::UniString& libPartName, API_LibPart& libPart) const;
 	GSErrCode	GetLocation (bool useEmbeddedLibrary, IO::Location*& libraryFolderLocation) const;
 	GS::UInt64	GenerateFingerPrint (const GS::Array<GS::UniString>& hashIds) const;
+	GS::UInt64	GenerateContentFingerPrint (const ModelInfo& modelInfo) const;
+
+	GSErrCode	LoadLibraryIndex ();
+	GSErrCode	SaveLibraryIndex ();
 };
 
 #endif
@@ -26,11 +26,6 @@ Point3D::Point3D (const API_Coord3D& coord)
 {
 }
 
-Point3D::Point3D (const Point3D& other)
-	: x (other.x), y (other.y), z (other.z)
-{
-}
-
 const API_Coord Point3D::ToAPI_Coord () const
 {
 	API_Coord coord;
@@ -58,24 +53,11 @@ bool Point3D::operator==(const Point3D& rhs) const
 		return false;
 }
 
-Point3D& Point3D::operator=(const Point3D& other)
-{
-	if (this == &other) {
-		return *this;
-	}
-	x = other.x;
-	y = other.y;
-	z = other.z;
-
-	return *this;
-}
-
 GSErrCode Point3D::Restore (const GS::ObjectState& os)
 {
 	os.Get (FieldNames::Point::X, x);
 	os.Get (FieldNames::Point::Y, y);
 	os.Get (FieldNames::Point::Z, z);
-	os.Get (FieldNames::Point::Units, units);
 
 	return NoError;
 }
@@ -85,7 +67,6 @@ GSErrCode Point3D::Store (GS::ObjectState& os) const
 	os.Add (FieldNames::Point::X, x);
 	os.Add (FieldNames::Point::Y, y);
 	os.Add (FieldNames::Point::Z, z);
-	os.Add (FieldNames::Point::Units, units);
 
 	return NoError;
 }
\ No newline at end of file
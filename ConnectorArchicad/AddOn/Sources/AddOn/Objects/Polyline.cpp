@@ -2,6 +2,8 @@
 #include "ObjectState.hpp"
 #include "FieldNames.hpp"
 
+#include <cstring>
+
 
 using namespace Objects;
 
@@ -14,6 +16,31 @@ static const char* ContourPolyFieldName = "contourPolyline";
 static const char* HolePolylinesFieldName = "holePolylines";
 
 
+namespace {
+
+// exact (x, y) coordinate as a hash key, -0.0 and 0.0 are the same coordinate
+class CoordKey {
+public:
+	double x, y;
+
+	CoordKey (double x, double y) : x (x + 0.0), y (y + 0.0) {}
+
+	bool operator== (const CoordKey& other) const { return x == other.x && y == other.y; }
+
+	ULong GenerateHashValue (void) const
+	{
+		GS::UInt64 xBits = 0, yBits = 0;
+		memcpy (&xBits, &x, sizeof (double));
+		memcpy (&yBits, &y, sizeof (double));
+
+		GS::UInt64 hash = xBits * 0x9E3779B97F4A7C15ULL ^ (yBits + 0x632BE59BD9B4E019ULL + (xBits << 6) + (xBits >> 2));
+		return (ULong) (hash ^ (hash >> 32));
+	}
+};
+
+}
+
+
 PolylineSegment::PolylineSegment (const Point3D& start, const Point3D& end, double angle, GS::Optional<bool> bodyFlag /*= GS::NoValue*/)
 	: startPoint (start)
 	, endPoint (end)
@@ -60,22 +87,13 @@ Polyline::Polyline (const GS::Array<PolylineSegment>& curveSegments)
 
 void Polyline::FillVertices ()
 {
+	// the segments follow each other, a segment's start point is the end point of the previous one
 	mVertices.Clear ();
+	mVertices.SetCapacity (mPolylineSegments.GetSize () + 1);
 	for (const PolylineSegment& segment : mPolylineSegments) {
-		Point3D sPoint = segment.startPoint;
-		Point3D ePoint = segment.endPoint;
-		bool sFound = false;
-		bool eFound = false;
-		for (UInt32 i = 1; i < mVertices.GetSize (); i++) {
-			if (mVertices[i] == sPoint)
-				sFound = true;
-			if (mVertices[i] == ePoint)
-				eFound = true;
-		}
-		if (!sFound)
-			mVertices.Push (sPoint);
-		if (!eFound)
-			mVertices.Push (ePoint);
+		if (mVertices.IsEmpty () || !(mVertices.GetLast () == segment.startPoint))
+			mVertices.Push (segment.startPoint);
+		mVertices.Push (segment.endPoint);
 	}
 }
 
@@ -193,6 +211,13 @@ ElementShape::ElementShape (const API_Polygon& outlinePoly, const API_ElementMem
 		parcs = memo.shellContours[idx].parcs;
 	}
 
+	// arc angles keyed by the arc's begin coordinate index
+	GS::HashTable<Int32, double> arcAngles;
+	for (int k = 0; k < nPolyArcs; k++) {
+		if (!arcAngles.ContainsKey ((*(parcs))[k].begIndex))
+			arcAngles.Add ((*(parcs))[k].begIndex, (*(parcs))[k].arcAngle);
+	}
+
 	Int32 sIndex = 1;
 	for (int i = 1; i <= nSubPolys; i++) {
 
@@ -206,13 +231,7 @@ ElementShape::ElementShape (const API_Polygon& outlinePoly, const API_ElementMem
 			Point3D startPoint = Point3D (sPoint.x, sPoint.y, level);
 			Point3D endPoint = Point3D (ePoint.x, ePoint.y, level);
 			double arcAngle = 0;
-
-			for (int k = 0; k < nPolyArcs; k++) {
-				if ((*(parcs))[k].begIndex == j) {
-					arcAngle = (*(parcs))[k].arcAngle;
-					break;
-				}
-			}
+			arcAngles.Get (j, &arcAngle);
 
 			if (bodyFlags != nullptr) {
 				// segment's start point defines the segment's bodyFlag
@@ -319,93 +338,81 @@ void ElementShape::SetToMemo (API_ElementMemo& memo, MemoPolygonType memoPolygon
 	BMhKill ((GSHandle*) contourIDs);
 	BMhKill ((GSHandle*) bodyFlags);
 
-	GS::Array<Polyline> polylines;
+	GS::Array<const Polyline*> polylines;
 
-	polylines.Push (mContourPoly);
-	polylines.Append (mHoles);
+	polylines.Push (&mContourPoly);
+	for (const Polyline& hole : mHoles)
+		polylines.Push (&hole);
 
 	GS::Int32 nSubPolys = GS::Int32 (polylines.GetSize ());
 	GS::Int32 nCoords = 0;
 	GS::Int32 nArcs = 0;
-
-	*pends = (Int32**) BMAllocateHandle ((nSubPolys + 1) * sizeof (Int32), ALLOCATE_CLEAR, 0);
-	(*(*pends))[0] = 0;
-	int count = 0;
-	for (UInt32 j = 0; j < polylines.GetSize (); j++) {
-		(*(*pends))[j + 1] = (*(*pends))[j] + polylines[j].VertexCount ();
-		count += polylines[j].ArcCount ();
+	for (const Polyline* polyline : polylines) {
+		nCoords += polyline->VertexCount ();
+		nArcs += polyline->ArcCount ();
 	}
 
-	nCoords = GS::Int32 ((*(*pends))[polylines.GetSize ()]);
-	nArcs = GS::Int32 (count);
-
+	*pends = reinterpret_cast<Int32**> (BMAllocateHandle ((nSubPolys + 1) * sizeof (Int32), ALLOCATE_CLEAR, 0));
 	*coords = reinterpret_cast<API_Coord**> (BMAllocateHandle ((nCoords + 1) * sizeof (API_Coord), ALLOCATE_CLEAR, 0));
 	*vertexIDs = reinterpret_cast<UInt32**> (BMAllocateHandle ((nCoords + 1) * sizeof (Int32), ALLOCATE_CLEAR, 0));
 	*parcs = reinterpret_cast<API_PolyArc**> (BMAllocateHandle (nArcs * sizeof (API_PolyArc), ALLOCATE_CLEAR, 0));
 	if (bodyFlags != nullptr)
 		*bodyFlags = reinterpret_cast<bool**> (BMAllocateHandle ((nCoords + 1) * sizeof (bool), ALLOCATE_CLEAR, 0));
 
-	((UInt32*) **vertexIDs)[0] = nCoords;
-	UInt32 coIndex = 1;
+	// coincident coordinates share their vertex id, in any of the subpolygons
+	GS::HashTable<CoordKey, UInt32> vertexIdsByCoord;
 	UInt32 vId = 1;
-	for (UInt32 j = 0; j < polylines.GetSize (); j++) {
-		for (UInt32 k = 0; k < (UInt32) polylines[j].VertexCount (); ++k) {
-			const Point3D* point = polylines[j].PointAt (k);
-			if (point != nullptr) {
-				(*(*coords))[coIndex].x = point->x;
-				(*(*coords))[coIndex].y = point->y;
-				bool fId = false;
-				for (UInt32 m = 1; m < coIndex; m++) {
-					if ((*(*coords))[m].x == point->x && (*(*coords))[m].y == point->y) {
-						(*(*vertexIDs))[coIndex] = (*(*vertexIDs))[m];
-						fId = true;
-						break;
-					}
-				}
-				if (!fId) {
-					(*(*vertexIDs))[coIndex] = vId;
-					vId++;
-				}
-			}
+	Int32 coIndex = 0;
+	Int32 iArc = 0;
+
+	auto pushVertex = [&] (const Point3D& point) {
+		++coIndex;
+		(**coords)[coIndex].x = point.x;
+		(**coords)[coIndex].y = point.y;
+
+		CoordKey key (point.x, point.y);
+		UInt32* vertexId = vertexIdsByCoord.GetPtr (key);
+		if (vertexId != nullptr) {
+			(**vertexIDs)[coIndex] = *vertexId;
+		} else {
+			(**vertexIDs)[coIndex] = vId;
+			vertexIdsByCoord.Add (key, vId);
+			vId++;
+		}
+	};
 
-			if (bodyFlags != nullptr) {
-				// set the start point's body flag
-				const PolylineSegment* segment = polylines[j].SegmentAt (k);
-				if (segment != nullptr && segment->bodyFlag.HasValue () && segment->bodyFlag.Get () == true) {
-					(*(*bodyFlags))[coIndex] = true;
-				}
-			}
+	// the vertices are produced in the same order as Polyline::FillVertices does
+	(**pends)[0] = 0;
+	for (GS::Int32 j = 0; j < nSubPolys; j++) {
+		const GS::Array<PolylineSegment>& segments = polylines[j]->GetSegments ();
+		const Point3D* lastPoint = nullptr;
+		for (UInt32 k = 0; k < segments.GetSize (); k++) {
+			const PolylineSegment& segment = segments[k];
 
-			coIndex++;
-		}
-	}
-	(*(*vertexIDs))[0] = vId - 1;
-
-	UInt32 iArc = 0;
-	UInt32 offset = 0;
-	for (UInt32 l = 0; l < polylines.GetSize (); l++) {
-		for (UInt32 n = 0; n < (UInt32) polylines[l].ArcCount (); n++) {
-			const PolylineSegment* arc = polylines[l].ArcAt (n);
-			if (arc != nullptr) {
-				UInt32 beg = 0, end = 0;
-				for (UInt32 k = 0; k < (UInt32) polylines[l].VertexCount () - 1; ++k) {
-					const Point3D* point = polylines[l].PointAt (k);
-					if (beg == 0 && point != nullptr && *(point) == arc->startPoint)
-						beg = k + 1;
-					point = polylines[l].PointAt (k + 1);
-					if (end == 0 && point != nullptr && *(point) == arc->endPoint)
-						end = k + 2;
-				}
-				if (beg != 0 && end != 0) {
-					(**parcs)[iArc].begIndex = beg + offset;
-					(**parcs)[iArc].endIndex = end + offset;
-					(**parcs)[iArc].arcAngle = arc->arcAngle;
-					++iArc;
-				}
+			if (lastPoint == nullptr || !(*lastPoint == segment.startPoint))
+				pushVertex (segment.startPoint);
+
+			Int32 begIndex = coIndex;
+
+			// segment's start point defines the segment's bodyFlag
+			if (bodyFlags != nullptr && segment.bodyFlag.HasValue () && segment.bodyFlag.Get () == true)
+				(**bodyFlags)[begIndex] = true;
+
+			pushVertex (segment.endPoint);
+			lastPoint = &segment.endPoint;
+
+			if (segment.arcAngle != 0 && iArc < nArcs) {
+				(**parcs)[iArc].begIndex = begIndex;
+				(**parcs)[iArc].endIndex = coIndex;
+				(**parcs)[iArc].arcAngle = segment.arcAngle;
+				++iArc;
 			}
 		}
-		offset += GS::Int32 (polylines[l].VertexCount ());
+
+		(**pends)[j + 1] = coIndex;
 	}
+
+	(**vertexIDs)[0] = vId - 1;
 }
 
 
@@ -40,6 +40,8 @@ public:
 	int						VertexCount () const;
 	int						ArcCount () const;
 
+	inline const GS::Array<PolylineSegment>& GetSegments () const { return mPolylineSegments; }
+
 	const Point3D* 			PointAt (int index) const;
 	const PolylineSegment* 	ArcAt (int index) const;
 	const PolylineSegment* 	SegmentAt (int index) const;
@@ -0,0 +1,169 @@
+#include "PerformanceStats.hpp"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace PerformanceStats {
+
+
+namespace FieldNames
+{
+static const char* Counters = "counters";
+static const char* HistogramLimits = "histogramLimits";
+static const char* Name = "name";
+static const char* Count = "count";
+static const char* TotalTime = "totalTime";
+static const char* MeanTime = "meanTime";
+static const char* MaxTime = "maxTime";
+static const char* Histogram = "histogram";
+}
+
+
+namespace {
+
+struct Registry {
+	std::mutex								mutex;
+	std::vector<std::unique_ptr<Counter>>	counters;
+	GS::HashTable<GS::String, Counter*>		countersByName;
+};
+
+
+Registry& GetRegistry ()
+{
+	static Registry registry;
+	return registry;
+}
+
+
+double ToMilliseconds (GS::UInt64 nanoseconds)
+{
+	return nanoseconds / 1.0e6;
+}
+
+}
+
+
+Counter::Counter (const GS::String& name) :
+	name (name),
+	count (0),
+	totalNanoseconds (0),
+	maxNanoseconds (0)
+{
+	for (UInt32 i = 0; i < HistogramBucketCount; i++)
+		histogram[i].store (0, std::memory_order_relaxed);
+}
+
+
+void Counter::Add (GS::UInt64 nanoseconds)
+{
+	count.fetch_add (1, std::memory_order_relaxed);
+	totalNanoseconds.fetch_add (nanoseconds, std::memory_order_relaxed);
+
+	GS::UInt64 previousMax = maxNanoseconds.load (std::memory_order_relaxed);
+	while (nanoseconds > previousMax && !maxNanoseconds.compare_exchange_weak (previousMax, nanoseconds, std::memory_order_relaxed)) {
+	}
+
+	GS::UInt64 microseconds = nanoseconds / 1000;
+	UInt32 bucket = 0;
+	while (microseconds > 0 && bucket < HistogramBucketCount - 1) {
+		microseconds >>= 1;
+		bucket++;
+	}
+	histogram[bucket].fetch_add (1, std::memory_order_relaxed);
+}
+
+
+void Counter::Reset ()
+{
+	count.store (0, std::memory_order_relaxed);
+	totalNanoseconds.store (0, std::memory_order_relaxed);
+	maxNanoseconds.store (0, std::memory_order_relaxed);
+	for (UInt32 i = 0; i < HistogramBucketCount; i++)
+		histogram[i].store (0, std::memory_order_relaxed);
+}
+
+
+GS::ObjectState Counter::Store () const
+{
+	const GS::UInt64 callCount = count.load (std::memory_order_relaxed);
+	const GS::UInt64 total = totalNanoseconds.load (std::memory_order_relaxed);
+
+	GS::ObjectState os;
+	os.Add (FieldNames::Name, name);
+	os.Add (FieldNames::Count, callCount);
+	os.Add (FieldNames::TotalTime, ToMilliseconds (total));
+	os.Add (FieldNames::MeanTime, callCount > 0 ? ToMilliseconds (total / callCount) : 0.0);
+	os.Add (FieldNames::MaxTime, ToMilliseconds (maxNanoseconds.load (std::memory_order_relaxed)));
+
+	const auto& histogramAdder = os.AddList<GS::UInt64> (FieldNames::Histogram);
+	for (UInt32 i = 0; i < HistogramBucketCount; i++)
+		histogramAdder (histogram[i].load (std::memory_order_relaxed));
+
+	return os;
+}
+
+
+ScopedTimer::ScopedTimer (Counter& counter) :
+	counter (counter),
+	start (std::chrono::steady_clock::now ())
+{
+}
+
+
+ScopedTimer::~ScopedTimer ()
+{
+	const auto elapsed = std::chrono::steady_clock::now () - start;
+	counter.Add (static_cast<GS::UInt64> (std::chrono::duration_cast<std::chrono::nanoseconds> (elapsed).count ()));
+}
+
+
+Counter& GetCounter (const GS::String& name)
+{
+	Registry& registry = GetRegistry ();
+	std::lock_guard<std::mutex> lock (registry.mutex);
+
+	Counter* counter = nullptr;
+	if (registry.countersByName.Get (name, &counter))
+		return *counter;
+
+	registry.counters.push_back (std::unique_ptr<Counter> (new Counter (name)));
+	counter = registry.counters.back ().get ();
+	registry.countersByName.Add (name, counter);
+
+	return *counter;
+}
+
+
+void ResetAll ()
+{
+	Registry& registry = GetRegistry ();
+	std::lock_guard<std::mutex> lock (registry.mutex);
+
+	for (const auto& counter : registry.counters)
+		counter->Reset ();
+}
+
+
+GS::ObjectState StoreAll ()
+{
+	GS::ObjectState result;
+
+	// upper limits of the histogram buckets in microseconds, the last bucket has no limit
+	const auto& limitAdder = result.AddList<GS::UInt64> (FieldNames::HistogramLimits);
+	for (UInt32 i = 0; i < Counter::HistogramBucketCount - 1; i++)
+		limitAdder (GS::UInt64 (1) << i);
+
+	Registry& registry = GetRegistry ();
+	std::lock_guard<std::mutex> lock (registry.mutex);
+
+	const auto& counterAdder = result.AddList<GS::ObjectState> (FieldNames::Counters);
+	for (const auto& counter : registry.counters)
+		counterAdder (counter->Store ());
+
+	return result;
+}
+
+
+}
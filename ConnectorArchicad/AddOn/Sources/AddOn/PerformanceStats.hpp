@@ -0,0 +1,86 @@
+#ifndef PERFORMANCE_STATS_HPP
+#define PERFORMANCE_STATS_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+#include "ObjectState.hpp"
+
+#include <atomic>
+#include <chrono>
+
+
+namespace PerformanceStats {
+
+
+namespace CounterNames
+{
+static const char* SerializeElementType = "SerializeElementType";
+static const char* MeshExtraction = "MeshExtraction";
+static const char* GDLWriting = "GDLWriting";
+static const char* ResponseEncoding = "ResponseEncoding";
+static const char* AttributeApi = "ACAPI.Attribute";
+static const char* PropertyApi = "ACAPI.Property";
+static const char* ClassificationApi = "ACAPI.Classification";
+static const char* QuantityApi = "ACAPI.Quantity";
+static const char* ElementGetApi = "ACAPI.ElementGet";
+static const char* ElementChangeApi = "ACAPI.ElementChange";
+}
+
+
+/*!
+ Aggregated timings of one instrumented operation
+ Updates only touch relaxed atomics, so a counter can be fed from any thread without locking
+ */
+class Counter {
+public:
+	static const UInt32 HistogramBucketCount = 24;
+
+	explicit Counter (const GS::String& name);
+
+	Counter (const Counter&) = delete;
+	void operator= (const Counter&) = delete;
+
+	void				Add (GS::UInt64 nanoseconds);
+	void				Reset ();
+
+	const GS::String&	GetName () const { return name; }
+	GS::ObjectState		Store () const;
+
+private:
+	GS::String				name;
+	std::atomic<GS::UInt64>	count;
+	std::atomic<GS::UInt64>	totalNanoseconds;
+	std::atomic<GS::UInt64>	maxNanoseconds;
+		///Call counts by duration, bucket i holds the calls shorter than 2^i microseconds, the last one all the longer calls
+	std::atomic<GS::UInt64>	histogram[HistogramBucketCount];
+};
+
+
+/*!
+ Adds the lifetime of the enclosing scope to a counter
+ */
+class ScopedTimer {
+public:
+	explicit ScopedTimer (Counter& counter);
+	~ScopedTimer ();
+
+	ScopedTimer (const ScopedTimer&) = delete;
+	void operator= (const ScopedTimer&) = delete;
+
+private:
+	Counter&								counter;
+	std::chrono::steady_clock::time_point	start;
+};
+
+
+	///The counter registered with the given name, created on first use. The reference stays valid while the add-on is loaded,
+	///so call sites with a fixed name keep it in a function level static and skip the lookup on later calls.
+Counter&		GetCounter (const GS::String& name);
+void			ResetAll ();
+GS::ObjectState	StoreAll ();
+
+
+}
+
+
+#endif
@@ -1,6 +1,7 @@
 #include "PropertyExportManager.hpp"
 #include "Utility.hpp"
 #include "MD5Channel.hpp"
+#include "PerformanceStats.hpp"
 
 PropertyExportManager* PropertyExportManager::instance = nullptr;
 
@@ -285,106 +286,305 @@ GS::UInt64 GenerateFingerPrint (const API_ElemType& elementType, const bool& sen
 }
 
 
+static const API_AttributeIndex& GetStructureAttribute (const API_ModelElemStructureType& structureType, const API_AttributeIndex& buildingMaterial, const API_AttributeIndex& composite, const API_AttributeIndex& profileAttr)
+{
+	switch (structureType) {
+		case API_CompositeStructure:	return composite;
+		case API_ProfileStructure:		return profileAttr;
+		default:						return buildingMaterial;
+	}
+}
+
+
+static void WriteStructure (IO::MD5Channel& md5Channel, const API_ModelElemStructureType& structureType, const API_AttributeIndex& attributeIndex)
+{
+	md5Channel.Write (static_cast<Int32> (structureType));
+		//The attribute index is an integer before Archicad 27 and a class wrapping one since, it is hashed by its bytes in both cases
+	md5Channel.WriteBin (reinterpret_cast<const char*> (&attributeIndex), sizeof (API_AttributeIndex));
+}
+
+
+/*!
+ Create a hash of the structure of an element, elements with the same structure have the same components
+ @param element The target element
+ @param memo Memo data of the element, the beam and column segments are read from it
+ @param elementFingerPrint The fingerprint of the element property definitions (the component definitions are filtered by them)
+ @param fingerPrint The hash of the element structure (calculated in this function)
+ @return True if the element has a structure the component definitions can be cached by
+ */
+static bool GenerateStructureFingerPrint (const API_Element& element, const API_ElementMemo& memo, const GS::UInt64& elementFingerPrint, GS::UInt64& fingerPrint)
+{
+	IO::MD5Channel md5Channel;
+	MD5::FingerPrint checkSum;
+
+	md5Channel.Write (elementFingerPrint);
+
+	const API_ElemTypeID typeID = Utility::GetElementType (element.header).typeID;
+	switch (typeID) {
+		case API_WallID:
+			WriteStructure (md5Channel, element.wall.modelElemStructureType, GetStructureAttribute (element.wall.modelElemStructureType, element.wall.buildingMaterial, element.wall.composite, element.wall.profileAttr));
+			break;
+		case API_SlabID:
+				//Slabs, roofs and shells can't be profiled
+			WriteStructure (md5Channel, element.slab.modelElemStructureType, GetStructureAttribute (element.slab.modelElemStructureType, element.slab.buildingMaterial, element.slab.composite, element.slab.composite));
+			break;
+		case API_RoofID:
+			WriteStructure (md5Channel, element.roof.shellBase.modelElemStructureType, GetStructureAttribute (element.roof.shellBase.modelElemStructureType, element.roof.shellBase.buildingMaterial, element.roof.shellBase.composite, element.roof.shellBase.composite));
+			break;
+		case API_ShellID:
+			WriteStructure (md5Channel, element.shell.shellBase.modelElemStructureType, GetStructureAttribute (element.shell.shellBase.modelElemStructureType, element.shell.shellBase.buildingMaterial, element.shell.shellBase.composite, element.shell.shellBase.composite));
+			break;
+		case API_BeamID:
+		{
+				//Beam and column segments can't be composite, each segment is a component
+				//Without the segments in the memo (e.g. the memo mask of the command leaves them out) the structure is unknown
+			if (memo.beamSegments == nullptr)
+				return false;
+
+			GSSize segmentsCount = BMGetPtrSize (reinterpret_cast<GSPtr>(memo.beamSegments)) / sizeof (API_BeamSegmentType);
+			for (GSSize idx = 0; idx < segmentsCount; ++idx) {
+				const API_AssemblySegmentData& segmentData = memo.beamSegments[idx].assemblySegmentData;
+				WriteStructure (md5Channel, segmentData.modelElemStructureType, GetStructureAttribute (segmentData.modelElemStructureType, segmentData.buildingMaterial, segmentData.profileAttr, segmentData.profileAttr));
+			}
+			break;
+		}
+		case API_ColumnID:
+		{
+			if (memo.columnSegments == nullptr)
+				return false;
+
+			GSSize segmentsCount = BMGetPtrSize (reinterpret_cast<GSPtr>(memo.columnSegments)) / sizeof (API_ColumnSegmentType);
+			for (GSSize idx = 0; idx < segmentsCount; ++idx) {
+				const API_AssemblySegmentData& segmentData = memo.columnSegments[idx].assemblySegmentData;
+				WriteStructure (md5Channel, segmentData.modelElemStructureType, GetStructureAttribute (segmentData.modelElemStructureType, segmentData.buildingMaterial, segmentData.profileAttr, segmentData.profileAttr));
+			}
+			break;
+		}
+		default:
+			return false;
+	}
+
+	md5Channel.Finish (&checkSum);
+	fingerPrint = checkSum.GetUInt64Value ();
+	return true;
+}
+
+
 /*!
  Get property definitions for a specified element
  @param element The target element to retrieve the property definitions for
+ @param memo Memo data of the element, beams and columns without their segments in it don't share their component definitions
  @param sendProperties True to export the Archicad properties attached to the element
  @param sendListingParameters True to export calculated listing parameters from the element, e.g. top/bottom surface area etc
  @param systemItemPairs Array pairing a classification system ID against a classification item ID (attached to the target element)
- @param elementDefinitions The element property definitions (retrieved in this function)
- @param componentsDefinitions The component property definitions (paired with the component ID, retrieved in this function)
+ @param elementDefinitions The element property definitions (retrieved in this function, shared by all elements with the same fingerprint and valid until the next call)
+ @param components The components of the element (retrieved in this function)
+ @param componentsDefinitions The property definitions of each component, empty for a component without definitions (retrieved in this function, shared by all elements with the same structure and valid until the next call)
  @return NoError if the definitions were retrieved without errors
  */
-GSErrCode PropertyExportManager::GetElementDefinitions (const API_Element& element, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, GS::Array<API_PropertyDefinition>& elementDefinitions, GS::Array<GS::Pair<API_ElemComponentID, GS::Array<API_PropertyDefinition>>>& componentsDefinitions)
+GSErrCode PropertyExportManager::GetElementDefinitions (const API_Element& element, const API_ElementMemo& memo, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, const GS::Array<API_PropertyDefinition>*& elementDefinitions, GS::Array<API_ElemComponentID>& components, const GS::Array<GS::Array<API_PropertyDefinition>>*& componentsDefinitions)
 {
 	GSErrCode err = NoError;
 
 	API_ElemType elementType = Utility::GetElementType (element.header);
 
-	GS::Array<API_PropertyDefinition> elementUserDefinedDefinitions;
-	
-	// element-level properties
-	{
-			//Create a hash value for target element and prefs
-		GS::UInt64 fingerPrint = GenerateFingerPrint (elementType, sendProperties, sendListingParameters, systemItemPairs);
-			//If we've already encountered this combo, use the property definitions we already found (will always be the same - saves a lot of time)
-		if (cache.ContainsKey (fingerPrint)) {
-			elementDefinitions = cache.Get (fingerPrint).first;
-			elementUserDefinedDefinitions = cache.Get (fingerPrint).second;
-		} else {
-			if (sendProperties) {
-					//Collect user-defined property definitions for the target element when the user requests them
-				err = ACAPI_Element_GetPropertyDefinitions (element.header.guid, API_PropertyDefinitionFilter_UserDefined, elementUserDefinedDefinitions);
-				if (err != NoError)
-					return err;
-			}
+	const GS::Array<API_PropertyDefinition>* elementUserDefinedDefinitions = nullptr;
 
-			GS::Array<API_PropertyDefinition> elementUserLevelBuiltInDefinitions;
-			if (sendListingParameters) {
-					//Collect built-in property definitions for the target element when the user requests them
-				err = ACAPI_Element_GetPropertyDefinitions (element.header.guid, API_PropertyDefinitionFilter_UserLevelBuiltIn, elementUserLevelBuiltInDefinitions);
-				if (err != NoError)
-					return err;
-					//The list of definitions can include many things we don't want - filter it to definitions we're really interested in
-				err = FilterDefinitionsByDefinitionIds (elementUserLevelBuiltInDefinitions, propertyGroupFilter.elementPropertiesFilter);
-				if (err != NoError)
-					return err;
-			}
+	components.Clear ();
+	uncachedComponentDefinitions.Clear ();
+	componentsDefinitions = &uncachedComponentDefinitions;
+
+		//Create a hash value for target element and prefs
+	GS::UInt64 fingerPrint = GenerateFingerPrint (elementType, sendProperties, sendListingParameters, systemItemPairs);
+
+	// element-level properties
+		//If we've already encountered this combo, use the property definitions we already found (will always be the same - saves a lot of time)
+	if (!cache.ContainsKey (fingerPrint)) {
+		GS::Array<API_PropertyDefinition> elementUserDefinedDefinitions;
+		if (sendProperties) {
+				//Collect user-defined property definitions for the target element when the user requests them
+			err = ACAPI_Element_GetPropertyDefinitions (element.header.guid, API_PropertyDefinitionFilter_UserDefined, elementUserDefinedDefinitions);
+			if (err != NoError)
+				return err;
+		}
 
-			elementDefinitions = elementUserDefinedDefinitions;
-			elementDefinitions.Append (elementUserLevelBuiltInDefinitions);
-				//Add the definitions to the cache to save looking them up again for the same target specs
-			cache.Add (fingerPrint, GS::Pair<GS::Array<API_PropertyDefinition>, GS::Array<API_PropertyDefinition>> (elementDefinitions, elementUserDefinedDefinitions));
+		GS::Array<API_PropertyDefinition> elementUserLevelBuiltInDefinitions;
+		if (sendListingParameters) {
+				//Collect built-in property definitions for the target element when the user requests them
+			err = ACAPI_Element_GetPropertyDefinitions (element.header.guid, API_PropertyDefinitionFilter_UserLevelBuiltIn, elementUserLevelBuiltInDefinitions);
+			if (err != NoError)
+				return err;
+				//The list of definitions can include many things we don't want - filter it to definitions we're really interested in
+			err = FilterDefinitionsByDefinitionIds (elementUserLevelBuiltInDefinitions, propertyGroupFilter.elementPropertiesFilter);
+			if (err != NoError)
+				return err;
 		}
+
+		GS::Array<API_PropertyDefinition> definitions = elementUserDefinedDefinitions;
+		definitions.Append (elementUserLevelBuiltInDefinitions);
+			//Add the definitions to the cache to save looking them up again for the same target specs
+		cache.Add (fingerPrint, GS::Pair<GS::Array<API_PropertyDefinition>, GS::Array<API_PropertyDefinition>> (definitions, elementUserDefinedDefinitions));
 	}
+		//The cached arrays are handed out without copying them for each element
+	const auto& cachedDefinitions = cache.Get (fingerPrint);
+	elementDefinitions = &cachedDefinitions.first;
+	elementUserDefinedDefinitions = &cachedDefinitions.second;
 
 	// components properties
 	// because of performance reasons components are skipped for complex elements
 	if (complexElementsToSkipFromComponentListing.Contains (elementType))
 		return NoError;
 
-	GS::Array<API_ElemComponentID> components;
 	err = ACAPI_Element_GetComponents (element.header.guid, components);
 	if (err != NoError)
 		return err;
 
-	componentsDefinitions.Clear ();
+		//Elements with the same structure (composite, profile or building material) have the same components, use the definitions we already found for them
+	GS::UInt64 structureFingerPrint = 0;
+	const bool hasStructure = GenerateStructureFingerPrint (element, memo, fingerPrint, structureFingerPrint);
+	if (hasStructure && componentCache.ContainsKey (structureFingerPrint)) {
+		const auto& cachedComponentDefinitions = componentCache.Get (structureFingerPrint);
+			//A structure edited since it was cached can have a different number of components, its definitions are looked up again
+		if (cachedComponentDefinitions.GetSize () == components.GetSize ()) {
+			componentsDefinitions = &cachedComponentDefinitions;
+			return NoError;
+		}
+
+		componentCache.Delete (structureFingerPrint);
+	}
+
+	GS::Array<GS::Array<API_PropertyDefinition>> definitions;
+	bool allRetrieved = true;
 	for (auto& component : components) {
-		GS::Array<API_PropertyDefinition> componentUserDefinedDefinitions;
+		GS::Array<API_PropertyDefinition> componentDefinitions;
+			//A component without definitions is kept with an empty array, so the definitions stay paired with the components by index
+		if (GetComponentDefinitions (component, sendProperties, sendListingParameters, *elementUserDefinedDefinitions, componentDefinitions) != NoError) {
+			componentDefinitions.Clear ();
+			allRetrieved = false;
+		}
 
-		if (sendProperties) {
+		definitions.Push (componentDefinitions);
+	}
+
+		//A failed lookup is not cached, the next element of the same structure tries again
+	if (hasStructure && allRetrieved) {
+		componentCache.Add (structureFingerPrint, definitions);
+		componentsDefinitions = &componentCache.Get (structureFingerPrint);
+	} else {
+		uncachedComponentDefinitions = definitions;
+	}
+
+	return NoError;
+}
+
+
+/*!
+ Get property definitions for a component of an element
+ @param component The target component
+ @param sendProperties True to export the Archicad properties attached to the component
+ @param sendListingParameters True to export the built-in component and building material properties
+ @param elementUserDefinedDefinitions The user-defined definitions of the element, these are left out from the component definitions
+ @param componentDefinitions The component property definitions (retrieved in this function)
+ @return NoError if the definitions were retrieved without errors
+ */
+GSErrCode PropertyExportManager::GetComponentDefinitions (const API_ElemComponentID& component, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<API_PropertyDefinition>& elementUserDefinedDefinitions, GS::Array<API_PropertyDefinition>& componentDefinitions)
+{
+	GSErrCode err = NoError;
+
+	if (sendProperties) {
 #ifdef ServerMainVers_2700
-			err = ACAPI_Element_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserDefined, componentUserDefinedDefinitions);
+		err = ACAPI_Element_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserDefined, componentDefinitions);
 #else
-			err = ACAPI_ElemComponent_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserDefined, componentUserDefinedDefinitions);
+		err = ACAPI_ElemComponent_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserDefined, componentDefinitions);
 #endif
-			if (err != NoError)
-				continue;
+		if (err != NoError)
+			return err;
 
-			err = FilterOutDefinitionsByDefinitions (componentUserDefinedDefinitions, elementUserDefinedDefinitions);
-			if (err != NoError)
-				continue;
-		}
+		err = FilterOutDefinitionsByDefinitions (componentDefinitions, elementUserDefinedDefinitions);
+		if (err != NoError)
+			return err;
+	}
 
-		GS::Array<API_PropertyDefinition> componentUserLevelBuiltInDefinitions;
-		if (sendListingParameters) {
+	GS::Array<API_PropertyDefinition> componentUserLevelBuiltInDefinitions;
+	if (sendListingParameters) {
 #ifdef ServerMainVers_2700
-			err = ACAPI_Element_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserLevelBuiltIn, componentUserLevelBuiltInDefinitions);
+		err = ACAPI_Element_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserLevelBuiltIn, componentUserLevelBuiltInDefinitions);
 #else
-			err = ACAPI_ElemComponent_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserLevelBuiltIn, componentUserLevelBuiltInDefinitions);
+		err = ACAPI_ElemComponent_GetPropertyDefinitions (component, API_PropertyDefinitionFilter_UserLevelBuiltIn, componentUserLevelBuiltInDefinitions);
 #endif
-			if (err != NoError)
-				continue;
+		if (err != NoError)
+			return err;
 
-			err = FilterDefinitionsByPropertyGroup (componentUserLevelBuiltInDefinitions, propertyGroupFilter.componentPropertyGroupFilter);
-			if (err != NoError)
-				continue;
-		}
+		err = FilterDefinitionsByPropertyGroup (componentUserLevelBuiltInDefinitions, propertyGroupFilter.componentPropertyGroupFilter);
+		if (err != NoError)
+			return err;
+	}
+
+	componentDefinitions.Append (componentUserLevelBuiltInDefinitions);
+
+	return NoError;
+}
+
+
+GS::UInt64 GenerateFingerPrint (const GS::Array<API_PropertyDefinition>& definitions)
+{
+	IO::MD5Channel md5Channel;
+	MD5::FingerPrint checkSum;
+
+	for (const auto& definition : definitions)
+		md5Channel.Write (APIGuid2GSGuid (definition.guid));
+
+	md5Channel.Finish (&checkSum);
+	return checkSum.GetUInt64Value ();
+}
+
+
+/*!
+ Drop the cached definitions and group layouts, the properties and their groups may have been renamed or deleted since they were cached
+ */
+void PropertyExportManager::Invalidate ()
+{
+	cache.Clear ();
+	componentCache.Clear ();
+	uncachedComponentDefinitions.Clear ();
+	groupLayouts.Clear ();
+}
+
+
+/*!
+ Get the property groups of a set of property definitions
+ The groups are looked up once for each distinct definition set, elements sharing definitions (see GetElementDefinitions) share the layout
+ @param definitions The property definitions to group
+ @return The groups in the order of their first definition, definitions with a group that can't be retrieved are left out (valid until the next call)
+ */
+const PropertyExportManager::PropertyGroupLayout& PropertyExportManager::GetGroupLayout (const GS::Array<API_PropertyDefinition>& definitions)
+{
+	GS::UInt64 fingerPrint = GenerateFingerPrint (definitions);
+	if (groupLayouts.ContainsKey (fingerPrint))
+		return groupLayouts.Get (fingerPrint);
+
+	static PerformanceStats::Counter& propertyCounter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::PropertyApi);
+
+	PropertyGroupLayout layout;
+	for (const auto& definition : definitions) {
+		if (layout.groupIndices.ContainsKey (definition.groupGuid))
+			continue;
 
-		componentUserDefinedDefinitions.Append (componentUserLevelBuiltInDefinitions);
+		API_PropertyGroup group;
+		group.guid = definition.groupGuid;
 
-		componentsDefinitions.Push (GS::Pair<API_ElemComponentID, GS::Array<API_PropertyDefinition>> (component, componentUserDefinedDefinitions));
+		GSErrCode err = NoError;
+		{
+			PerformanceStats::ScopedTimer timer (propertyCounter);
+			err = ACAPI_Property_GetPropertyGroup (group);
+		}
+		if (err != NoError)
+			continue;
+
+		layout.groupIndices.Add (group.guid, layout.groups.GetSize ());
+		layout.groups.Push (GS::Pair<API_Guid, GS::UniString> (group.guid, group.name));
 	}
 
-	return NoError;
+	groupLayouts.Add (fingerPrint, layout);
+	return groupLayouts.Get (fingerPrint);
 }
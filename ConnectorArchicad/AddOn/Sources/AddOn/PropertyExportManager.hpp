@@ -22,6 +22,21 @@ private:
 		///Cache of property definitions keyed by a hash of the target specifications (e.g. element type) - saves looking these up repeatedly
 	GS::HashTable<GS::UInt64, GS::Pair<GS::Array<API_PropertyDefinition>, GS::Array<API_PropertyDefinition>>> cache;
 
+public:
+		///The property groups of a set of definitions, in the order of their first definition
+	struct PropertyGroupLayout {
+		GS::Array<GS::Pair<API_Guid, GS::UniString>>	groups;
+		GS::HashTable<API_Guid, UInt32>					groupIndices;
+	};
+
+private:
+		///Cache of component property definitions keyed by a hash of the element fingerprint and the element structure (composite, profile or building material), one array per component
+	GS::HashTable<GS::UInt64, GS::Array<GS::Array<API_PropertyDefinition>>> componentCache;
+		///The component definitions of the last element without a cacheable structure
+	GS::Array<GS::Array<API_PropertyDefinition>> uncachedComponentDefinitions;
+		///Cache of property group layouts keyed by a hash of the definition IDs - saves looking up the groups for every element sharing a definition set
+	GS::HashTable<GS::UInt64, PropertyGroupLayout> groupLayouts;
+
 protected:
 	PropertyExportManager ();
 
@@ -31,7 +46,12 @@ public:
 	static PropertyExportManager* GetInstance ();
 	static void					DeleteInstance ();
 
-	GSErrCode	GetElementDefinitions (const API_Element& element, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, GS::Array<API_PropertyDefinition>& elementsDefinitions, GS::Array < GS::Pair<API_ElemComponentID, GS::Array<API_PropertyDefinition>>>& componentsDefinitions);
+	GSErrCode	GetElementDefinitions (const API_Element& element, const API_ElementMemo& memo, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<GS::Pair<API_Guid, API_Guid>>& systemItemPairs, const GS::Array<API_PropertyDefinition>*& elementDefinitions, GS::Array<API_ElemComponentID>& components, const GS::Array<GS::Array<API_PropertyDefinition>>*& componentsDefinitions);
+	const PropertyGroupLayout&	GetGroupLayout (const GS::Array<API_PropertyDefinition>& definitions);
+	void		Invalidate ();
+
+private:
+	GSErrCode	GetComponentDefinitions (const API_ElemComponentID& component, const bool& sendProperties, const bool& sendListingParameters, const GS::Array<API_PropertyDefinition>& elementUserDefinedDefinitions, GS::Array<API_PropertyDefinition>& componentDefinitions);
 };
 
 #endif
@@ -47,5 +47,10 @@
 #define CreateZoneCommandName					"CreateZone";
 #define SelectElementsCommandName				"SelectElements";
 #define EndCreateTransactionCommandName			"FinishReceiveTransaction";
+#define GetPerformanceStatsCommandName			"GetPerformanceStats";
+#define ResetPerformanceStatsCommandName		"ResetPerformanceStats";
+#define GetChangesSinceCommandName				"GetChangesSince";
+#define ConnectorHeartbeatCommandName			"ConnectorHeartbeat";
+#define RemoveUnusedLibraryPartsCommandName		"RemoveUnusedLibraryParts";
 
 #endif
@@ -0,0 +1,81 @@
+#include "ResponseDictionary.hpp"
+#include "FieldNames.hpp"
+#include "Objects/Level.hpp"
+
+
+UInt32 ResponseDictionary::StringTable::Add (const GS::UniString& name)
+{
+	UInt32 index = 0;
+	if (!indices.Get (name, &index)) {
+		index = names.GetSize ();
+		names.Push (name);
+		indices.Add (name, index);
+	}
+
+	return index;
+}
+
+
+void ResponseDictionary::StringTable::Store (GS::ObjectState& os, const char* fieldName) const
+{
+	const auto& listAdder = os.AddList<GS::UniString> (fieldName);
+	for (const GS::UniString& name : names)
+		listAdder (name);
+}
+
+
+UInt32 ResponseDictionary::AddLevel (const API_StoryType& story)
+{
+	UInt32 index = 0;
+	if (!levelIndices.Get (story.index, &index)) {
+		index = levels.GetSize ();
+		levels.Push (story);
+		levelIndices.Add (story.index, index);
+	}
+
+	return index;
+}
+
+
+UInt32 ResponseDictionary::AddLayer (const GS::UniString& name)
+{
+	return layers.Add (name);
+}
+
+
+UInt32 ResponseDictionary::AddMaterial (const GS::UniString& name)
+{
+	return materials.Add (name);
+}
+
+
+UInt32 ResponseDictionary::AddPropertyGroup (const GS::UniString& name)
+{
+	return propertyGroups.Add (name);
+}
+
+
+UInt32 ResponseDictionary::AddPropertyName (const GS::UniString& name)
+{
+	return propertyNames.Add (name);
+}
+
+
+void ResponseDictionary::Store (GS::ObjectState& os) const
+{
+	GS::ObjectState dictionariesOs;
+
+	const auto& levelAdder = dictionariesOs.AddList<GS::ObjectState> (FieldNames::Dictionaries::Levels);
+	for (const API_StoryType& story : levels) {
+		GS::ObjectState levelOs;
+		Objects::Level (story).Store (levelOs);
+		levelAdder (levelOs);
+	}
+
+	layers.Store (dictionariesOs, FieldNames::Dictionaries::Layers);
+	materials.Store (dictionariesOs, FieldNames::Dictionaries::Materials);
+	propertyGroups.Store (dictionariesOs, FieldNames::Dictionaries::PropertyGroups);
+	propertyNames.Store (dictionariesOs, FieldNames::Dictionaries::PropertyNames);
+
+	os.Add (FieldNames::Dictionaries::Dictionaries, dictionariesOs);
+}
@@ -0,0 +1,41 @@
+#ifndef RESPONSE_DICTIONARY_HPP
+#define RESPONSE_DICTIONARY_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+#include "ObjectState.hpp"
+
+
+// Tables of the values repeated by the serialised elements of a response.
+// The elements store the index of the level, layer, material, property group name and property name,
+// the tables are stored once at the root of the response.
+class ResponseDictionary {
+public:
+	UInt32		AddLevel (const API_StoryType& story);
+	UInt32		AddLayer (const GS::UniString& name);
+	UInt32		AddMaterial (const GS::UniString& name);
+	UInt32		AddPropertyGroup (const GS::UniString& name);
+	UInt32		AddPropertyName (const GS::UniString& name);
+
+	void		Store (GS::ObjectState& os) const;
+
+private:
+	class StringTable {
+	public:
+		UInt32	Add (const GS::UniString& name);
+		void	Store (GS::ObjectState& os, const char* fieldName) const;
+
+	private:
+		GS::Array<GS::UniString>				names;
+		GS::HashTable<GS::UniString, UInt32>	indices;
+	};
+
+	GS::Array<API_StoryType>		levels;
+	GS::HashTable<short, UInt32>	levelIndices;
+	StringTable						layers;
+	StringTable						materials;
+	StringTable						propertyGroups;
+	StringTable						propertyNames;
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "ResponseEncoder.hpp"
+#include "FieldNames.hpp"
+#include "PerformanceStats.hpp"
+#include "Deflate.hpp"
+#include "ObjectStateJSONConversion.hpp"
+#include "JSON/JDOMStringWriter.hpp"
+
+#include <string>
+
+
+namespace ResponseEncoder {
+
+
+static GSErrCode SerializeToJson (const GS::ObjectState& os, std::string& json)
+{
+	try {
+		JSON::JDOMStringWriter writer;
+		writer.Write (JSON::CreateFromObjectState (os));
+		json = writer.GetString ().ToCStr (0, MaxUSize, CC_UTF8).Get ();
+	} catch (...) {
+		return Error;
+	}
+
+	return NoError;
+}
+
+
+/*!
+ Replace a response with its compressed envelope
+ @param encoding The requested encoding, only deflate is supported
+ @param response The response to encode
+ @param encodedResponse The envelope with the encoding, the base64 payload, the uncompressed size and the checksum (out)
+ @return An error code (NoError = success), the response should be sent as it is on error
+ */
+GSErrCode Encode (const GS::UniString& encoding, const GS::ObjectState& response, GS::ObjectState& encodedResponse)
+{
+	if (encoding != FieldNames::ResponseEncoding::Deflate)
+		return Error;
+
+	static PerformanceStats::Counter& counter = PerformanceStats::GetCounter (PerformanceStats::CounterNames::ResponseEncoding);
+	PerformanceStats::ScopedTimer timer (counter);
+
+	std::string json;
+	GSErrCode err = SerializeToJson (response, json);
+	if (err != NoError)
+		return err;
+
+	std::string compressed;
+	Deflate::Compress (json, compressed);
+
+	encodedResponse.Add (FieldNames::ResponseEncoding::Encoding, encoding);
+	encodedResponse.Add (FieldNames::ResponseEncoding::Payload, GS::UniString (Deflate::ToBase64 (compressed).c_str ()));
+	encodedResponse.Add (FieldNames::ResponseEncoding::Size, (GS::UInt64) json.size ());
+	encodedResponse.Add (FieldNames::ResponseEncoding::Checksum, Deflate::Adler32 (json));
+
+	return NoError;
+}
+
+
+}
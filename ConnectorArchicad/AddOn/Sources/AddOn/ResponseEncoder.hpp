@@ -0,0 +1,20 @@
+#ifndef RESPONSE_ENCODER_HPP
+#define RESPONSE_ENCODER_HPP
+
+#include "APIEnvir.h"
+#include "ACAPinc.h"
+#include "ObjectState.hpp"
+
+
+// Compressed envelope of the large command responses.
+// The response is serialised to JSON, deflated (RFC 1951, fixed Huffman codes) and returned base64 encoded
+// together with the size and the Adler-32 checksum of the uncompressed JSON, so the connector can tell a truncated payload.
+namespace ResponseEncoder {
+
+
+GSErrCode	Encode (const GS::UniString& encoding, const GS::ObjectState& response, GS::ObjectState& encodedResponse);
+
+
+}
+
+#endif
@@ -244,28 +244,34 @@ GSErrCode GetBaseElementData (API_Element& element, API_ElementMemo* memo, API_S
 
 bool IsElement3D (const API_Guid& guid)
 {
-	switch (GetElementType (guid).typeID) {
-	case API_WallID:
-	case API_ColumnID:
-	case API_BeamID:
-	case API_WindowID:
-	case API_DoorID:
-	case API_ObjectID:
-	case API_LampID:
-	case API_SlabID:
-	case API_RoofID:
-	case API_MeshID:
-	case API_ZoneID:
-	case API_CurtainWallID:
-	case API_ShellID:
-	case API_SkylightID:
-	case API_MorphID:
-	case API_StairID:
-	case API_RailingID:
-	case API_OpeningID:
-		return true;
-	default: return false;
-	}
+	return Get3DElementTypes ().Contains (GetElementType (guid).typeID);
+}
+
+
+const GS::Array<API_ElemTypeID>& Get3DElementTypes ()
+{
+	static const GS::Array<API_ElemTypeID> element3DTypes {
+		API_WallID,
+		API_ColumnID,
+		API_BeamID,
+		API_WindowID,
+		API_DoorID,
+		API_ObjectID,
+		API_LampID,
+		API_SlabID,
+		API_RoofID,
+		API_MeshID,
+		API_ZoneID,
+		API_CurtainWallID,
+		API_ShellID,
+		API_SkylightID,
+		API_MorphID,
+		API_StairID,
+		API_RailingID,
+		API_OpeningID
+	};
+
+	return element3DTypes;
 }
 
 
@@ -75,6 +75,8 @@ bool ElementExists (const API_Guid& guid);
 
 bool IsElement3D (const API_Guid& guid);
 
+const GS::Array<API_ElemTypeID>& Get3DElementTypes ();
+
 GSErrCode GetBaseElementData (API_Element& elem, API_ElementMemo* memo, API_SubElement** marker, GS::Array<GS::UniString>& log);
 
 GS::Array<API_StoryType> GetStoryItems ();
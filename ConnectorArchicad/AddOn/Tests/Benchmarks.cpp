@@ -0,0 +1,187 @@
+#include "BodyEdges.hpp"
+#include "Deflate.hpp"
+#include "GDLScriptWriter.hpp"
+#include "Polyline.hpp"
+#include "RealNumber.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+static const UInt32 DefaultSizes[] = { 10000, 100000 };
+
+
+/*!
+ The closed polyline of the given number of segments on a circle, its vertices are filled on construction
+ */
+static void PolylineVertices (UInt32 size)
+{
+	GS::Array<Objects::PolylineSegment> segments;
+	segments.SetCapacity (size);
+	for (UInt32 i = 0; i < size; i++) {
+		const double angle = 2.0 * PI * i / size;
+		const double nextAngle = 2.0 * PI * (i + 1) / size;
+		segments.Push (Objects::PolylineSegment (Objects::Point3D (cos (angle), sin (angle), 0.0), Objects::Point3D (cos (nextAngle), sin (nextAngle), 0.0)));
+	}
+
+	Objects::Polyline polyline (segments);
+	if (polyline.VertexCount () != (int) size + 1)
+		abort ();
+}
+
+
+/*!
+ A polygon of the given number of vertices with a hole, read from an element memo and written into another one
+ */
+static void ShapeToMemo (UInt32 size)
+{
+	const UInt32 contourSize = size - size / 4;
+	const UInt32 holeSize = size / 4;
+
+	API_ElementMemo source {};
+	source.coords = reinterpret_cast<API_Coord**> (BMAllocateHandle ((size + 3) * sizeof (API_Coord), ALLOCATE_CLEAR, 0));
+	source.pends = reinterpret_cast<Int32**> (BMAllocateHandle (3 * sizeof (Int32), ALLOCATE_CLEAR, 0));
+	source.parcs = reinterpret_cast<API_PolyArc**> (BMAllocateHandle (sizeof (API_PolyArc), ALLOCATE_CLEAR, 0));
+
+	// the subpolygons are closed, their last coordinate repeats the first one
+	Int32 coordIndex = 0;
+	const auto addRing = [&] (UInt32 ringSize, double radius) {
+		for (UInt32 i = 0; i <= ringSize; i++) {
+			const double angle = 2.0 * PI * (i % ringSize) / ringSize;
+			++coordIndex;
+			(*source.coords)[coordIndex].x = radius * cos (angle);
+			(*source.coords)[coordIndex].y = radius * sin (angle);
+		}
+	};
+	addRing (contourSize, 10.0);
+	(*source.pends)[1] = coordIndex;
+	addRing (holeSize, 1.0);
+	(*source.pends)[2] = coordIndex;
+
+	API_Polygon polygon {};
+	polygon.nCoords = coordIndex;
+	polygon.nSubPolys = 2;
+	polygon.nArcs = 0;
+
+	Objects::ElementShape shape (polygon, source, Objects::ElementShape::MemoMainPolygon);
+
+	API_ElementMemo target {};
+	shape.SetToMemo (target, Objects::ElementShape::MemoMainPolygon);
+	if ((*target.pends)[2] != coordIndex)
+		abort ();
+
+	for (API_ElementMemo* memo : { &source, &target }) {
+		BMhKill ((GSHandle*) &memo->coords);
+		BMhKill ((GSHandle*) &memo->pends);
+		BMhKill ((GSHandle*) &memo->parcs);
+		BMhKill ((GSHandle*) &memo->vertexIDs);
+		BMhKill ((GSHandle*) &memo->edgeIDs);
+		BMhKill ((GSHandle*) &memo->contourIDs);
+	}
+}
+
+
+/*!
+ The edges of a grid mesh of about the given number of quads, the inner edges are shared by two quads
+ */
+static void DirectShapeEdges (UInt32 size)
+{
+	const UInt32 rowSize = (UInt32) sqrt ((double) size);
+	const auto vertex = [rowSize] (UInt32 row, UInt32 column) { return row * (rowSize + 1) + column + 1; };
+
+	StubACAPI::Body body;
+	BodyEdges bodyEdges (&body);
+	for (UInt32 row = 0; row < rowSize; row++) {
+		for (UInt32 column = 0; column < rowSize; column++) {
+			const UInt32 quad[] = { vertex (row, column), vertex (row, column + 1), vertex (row + 1, column + 1), vertex (row + 1, column) };
+			for (UInt32 i = 0; i < 4; i++) {
+				Int32 edge = 0;
+				bodyEdges.GetEdge (quad[i], quad[(i + 1) % 4], edge);
+			}
+		}
+	}
+
+	if (body.edges.size () != 2 * rowSize * (rowSize + 1))
+		abort ();
+}
+
+
+/*!
+ A response JSON of the given number of walls with the fields the data commands send most, deflated and base64 encoded
+ */
+static void ResponseDeflate (UInt32 size)
+{
+	std::string json = "{\"walls\":[";
+	char element[512];
+	for (UInt32 i = 0; i < size; i++) {
+		snprintf (element, sizeof (element),
+			"%s{\"applicationId\":\"%08X-0000-0000-0000-000000000000\",\"layer\":\"Structural - Bearing\",\"level\":{\"index\":%u},"
+			"\"baseOffset\":%.17g,\"height\":3,\"startPoint\":{\"x\":%.17g,\"y\":%.17g,\"z\":0}}",
+			i == 0 ? "" : ",", i, i % 10, 0.1 * (i % 7), 0.37 * i, -0.11 * i);
+		json += element;
+	}
+	json += "]}";
+
+	std::string compressed;
+	Deflate::Compress (json, compressed);
+	const std::string payload = Deflate::ToBase64 (compressed);
+	const UInt32 checksum = Deflate::Adler32 (json);
+
+	printf ("    %zu bytes of JSON, %zu bytes deflated (%.1f%%), %zu bytes of base64, checksum %08X\n",
+		json.size (), compressed.size (), 100.0 * compressed.size () / json.size (), payload.size (), checksum);
+}
+
+
+/*!
+ The coordinates of a mesh of the given number of vertices written as the generated GDL scripts write them
+ */
+static void GDLNumberFormatting (UInt32 size)
+{
+	StubACAPI::ResetWrittenSections ();
+	{
+		GDLScriptWriter writer;
+		for (UInt32 i = 0; i < size; i++)
+			writer << "VERT " << 0.001 * i << ", " << -12.5 + 0.25 * i << ", " << 3.0 / (i + 1) << '\n';
+	}
+
+	if (StubACAPI::WrittenSections ().empty ())
+		abort ();
+}
+
+
+/*!
+ Run the workloads of the data conversion code, each with the numbers of elements given on the command line, or with 10k and 100k
+ */
+int main (int argc, char* argv[])
+{
+	std::vector<UInt32> sizes;
+	for (int i = 1; i < argc; i++)
+		sizes.push_back ((UInt32) strtoul (argv[i], nullptr, 10));
+	if (sizes.empty ())
+		sizes.assign (std::begin (DefaultSizes), std::end (DefaultSizes));
+
+	const std::vector<std::pair<const char*, std::function<void (UInt32)>>> workloads = {
+		{ "PolylineVertices", PolylineVertices },
+		{ "ShapeToMemo", ShapeToMemo },
+		{ "DirectShapeEdges", DirectShapeEdges },
+		{ "ResponseDeflate", ResponseDeflate },
+		{ "GDLNumberFormatting", GDLNumberFormatting }
+	};
+
+	for (const auto& workload : workloads) {
+		for (UInt32 size : sizes) {
+			const auto start = std::chrono::steady_clock::now ();
+			workload.second (size);
+			const auto end = std::chrono::steady_clock::now ();
+
+			printf ("%-20s %8u %10.2f ms\n", workload.first, size, std::chrono::duration<double, std::milli> (end - start).count ());
+		}
+	}
+
+	return StubACAPI::LiveHandleCount () == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,140 @@
+#include "BodyEdges.hpp"
+#include "TestUtility.hpp"
+
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+
+typedef std::vector<UInt32> Polygon;
+
+
+// the edges of the polygons as CreateDirectShape adds them, each polygon closed by its last edge
+static std::vector<std::vector<Int32>> AddPolygons (StubACAPI::Body& body, const std::vector<Polygon>& polygons)
+{
+	BodyEdges bodyEdges (&body);
+
+	std::vector<std::vector<Int32>> polygonEdges;
+	for (const Polygon& polygon : polygons) {
+		std::vector<Int32> edges;
+		for (size_t i = 0; i < polygon.size (); i++) {
+			Int32 edge = 0;
+			CHECK (bodyEdges.GetEdge (polygon[i], polygon[(i + 1) % polygon.size ()], edge) == NoError);
+			edges.push_back (edge);
+		}
+		polygonEdges.push_back (edges);
+	}
+
+	return polygonEdges;
+}
+
+
+// the signed edges of a polygon run around it, from its first vertex
+static bool RunsAround (const StubACAPI::Body& body, const Polygon& polygon, const std::vector<Int32>& edges)
+{
+	for (size_t i = 0; i < polygon.size (); i++) {
+		const StubACAPI::BodyEdge& edge = body.edges[std::abs (edges[i]) - 1];
+		const UInt32 start = edges[i] > 0 ? edge.vertex1 : edge.vertex2;
+		const UInt32 end = edges[i] > 0 ? edge.vertex2 : edge.vertex1;
+		if (start != polygon[i] || end != polygon[(i + 1) % polygon.size ()])
+			return false;
+	}
+
+	return true;
+}
+
+
+// a closed, consistently oriented mesh uses each edge once in each direction
+static bool UsesEachEdgeBothWays (const std::vector<std::vector<Int32>>& polygonEdges, size_t edgeCount)
+{
+	std::map<Int32, int> uses;
+	for (const auto& edges : polygonEdges) {
+		for (Int32 edge : edges)
+			uses[edge]++;
+	}
+
+	for (Int32 edge = 1; edge <= (Int32) edgeCount; edge++) {
+		if (uses[edge] != 1 || uses[-edge] != 1)
+			return false;
+	}
+
+	return uses.size () == 2 * edgeCount;
+}
+
+
+static void TestCube ()
+{
+	const std::vector<Polygon> faces = {
+		{ 1, 4, 3, 2 }, { 5, 6, 7, 8 },
+		{ 1, 2, 6, 5 }, { 2, 3, 7, 6 }, { 3, 4, 8, 7 }, { 4, 1, 5, 8 }
+	};
+
+	StubACAPI::Body body;
+	const auto polygonEdges = AddPolygons (body, faces);
+
+	CHECK (body.edges.size () == 12);
+	CHECK (UsesEachEdgeBothWays (polygonEdges, body.edges.size ()));
+
+	bool allRunAround = true;
+	for (size_t i = 0; i < faces.size (); i++)
+		allRunAround = allRunAround && RunsAround (body, faces[i], polygonEdges[i]);
+	CHECK (allRunAround);
+}
+
+
+// a polygon listing an edge in the direction of an earlier one, against the orientation of the mesh, still reuses it
+static void TestSameDirection ()
+{
+	StubACAPI::Body body;
+	const auto polygonEdges = AddPolygons (body, { { 1, 2, 3 }, { 1, 2, 4 } });
+
+	CHECK (body.edges.size () == 5);
+	CHECK (polygonEdges[1][0] == polygonEdges[0][0]);
+	CHECK (RunsAround (body, { 1, 2, 4 }, polygonEdges[1]));
+}
+
+
+static void TestGrid ()
+{
+	const UInt32 size = 100;
+	const auto vertex = [&] (UInt32 row, UInt32 column) { return row * (size + 1) + column + 1; };
+
+	std::vector<Polygon> quads;
+	for (UInt32 row = 0; row < size; row++) {
+		for (UInt32 column = 0; column < size; column++)
+			quads.push_back ({ vertex (row, column), vertex (row, column + 1), vertex (row + 1, column + 1), vertex (row + 1, column) });
+	}
+
+	StubACAPI::Body body;
+	const auto polygonEdges = AddPolygons (body, quads);
+
+	// the inner edges are shared, without sharing there would be 4 edges per quad
+	CHECK (body.edges.size () == 2 * size * (size + 1));
+
+	bool allRunAround = true;
+	for (size_t i = 0; i < quads.size (); i++)
+		allRunAround = allRunAround && RunsAround (body, quads[i], polygonEdges[i]);
+	CHECK (allRunAround);
+}
+
+
+// a failed edge is not remembered, the next request tries again
+static void TestError ()
+{
+	BodyEdges bodyEdges (nullptr);
+
+	Int32 edge = 0;
+	CHECK (bodyEdges.GetEdge (1, 2, edge) != NoError);
+	CHECK (bodyEdges.GetEdge (2, 1, edge) != NoError);
+}
+
+
+int main ()
+{
+	TestCube ();
+	TestSameDirection ();
+	TestGrid ();
+	TestError ();
+
+	return TestUtility::Result ();
+}
@@ -0,0 +1,155 @@
+#include "Deflate.hpp"
+#include "TestUtility.hpp"
+
+#include <chrono>
+#include <random>
+#include <string>
+
+#include <zlib.h>
+
+
+// zlib is the reference decoder, the raw deflate stream has no zlib header
+static bool Inflate (const std::string& compressed, size_t size, std::string& data)
+{
+	z_stream stream {};
+	if (inflateInit2 (&stream, -15) != Z_OK)
+		return false;
+
+	data.assign (size + 1, '\0');
+	stream.next_in = (Bytef*) compressed.data ();
+	stream.avail_in = (uInt) compressed.size ();
+	stream.next_out = (Bytef*) &data[0];
+	stream.avail_out = (uInt) data.size ();
+
+	const int result = inflate (&stream, Z_FINISH);
+	data.resize (stream.total_out);
+	inflateEnd (&stream);
+
+	return result == Z_STREAM_END;
+}
+
+
+static void CheckRoundTrip (const char* name, const std::string& data)
+{
+	std::string compressed;
+	Deflate::Compress (data, compressed);
+
+	std::string inflated;
+	const bool inflatedOk = Inflate (compressed, data.size (), inflated);
+	if (!inflatedOk || inflated != data)
+		printf ("round trip of %s (%zu bytes) failed\n", name, data.size ());
+
+	CHECK (inflatedOk);
+	CHECK (inflated == data);
+	CHECK (Deflate::Adler32 (data) == adler32 (adler32 (0, nullptr, 0), (const Bytef*) data.data (), (uInt) data.size ()));
+}
+
+
+static std::string RandomBytes (size_t size, unsigned int seed)
+{
+	std::mt19937 generator (seed);
+	std::string bytes (size, '\0');
+	for (char& byte : bytes)
+		byte = (char) (generator () & 0xFF);
+
+	return bytes;
+}
+
+
+static std::string ElementsJson (unsigned int count)
+{
+	std::string json = "{\"walls\":[";
+	char element[512];
+	for (unsigned int i = 0; i < count; i++) {
+		snprintf (element, sizeof (element),
+			"%s{\"applicationId\":\"%08X-0000-0000-0000-000000000000\",\"layer\":\"Structural - Bearing\",\"level\":{\"index\":%u},"
+			"\"baseOffset\":%.17g,\"height\":3,\"startPoint\":{\"x\":%.17g,\"y\":%.17g,\"z\":0}}",
+			i == 0 ? "" : ",", i, i % 10, 0.1 * (i % 7), 0.37 * i, -0.11 * i);
+		json += element;
+	}
+	json += "]}";
+
+	return json;
+}
+
+
+static void TestRoundTrips ()
+{
+	CheckRoundTrip ("the empty input", "");
+	CheckRoundTrip ("a single byte", "{");
+	CheckRoundTrip ("two bytes", "{}");
+	CheckRoundTrip ("three bytes", "abc");
+	CheckRoundTrip ("the literals above 143", RandomBytes (1000, 1));
+
+	// runs longer than the longest match, the matches overlap their own output
+	CheckRoundTrip ("a long run", std::string (1000, 'x'));
+	CheckRoundTrip ("a run of the longest match", std::string (259, 'x'));
+
+	// a 258 byte block repeated, the matches are exactly 258 long
+	const std::string block = RandomBytes (258, 2);
+	CheckRoundTrip ("repeated blocks of the longest match", block + block + block);
+
+	// the repetition of a block of the window size is at the largest distance
+	const std::string window = RandomBytes (32768, 3);
+	CheckRoundTrip ("a repetition at the largest distance", window + window.substr (0, 300));
+
+	// one byte further, the repetition is out of the window
+	const std::string beyondWindow = RandomBytes (32769, 4);
+	CheckRoundTrip ("a repetition beyond the window", beyondWindow + beyondWindow.substr (0, 300));
+
+	CheckRoundTrip ("the JSON of the elements", ElementsJson (5000));
+}
+
+
+static void TestBase64 ()
+{
+	// the test vectors of RFC 4648, with each padding
+	CHECK (Deflate::ToBase64 ("") == "");
+	CHECK (Deflate::ToBase64 ("f") == "Zg==");
+	CHECK (Deflate::ToBase64 ("fo") == "Zm8=");
+	CHECK (Deflate::ToBase64 ("foo") == "Zm9v");
+	CHECK (Deflate::ToBase64 ("foob") == "Zm9vYg==");
+	CHECK (Deflate::ToBase64 ("fooba") == "Zm9vYmE=");
+	CHECK (Deflate::ToBase64 ("foobar") == "Zm9vYmFy");
+	CHECK (Deflate::ToBase64 (std::string ("\xFB\xFF\x00", 3)) == "+/8A");
+}
+
+
+static void TestAdler32 ()
+{
+	CHECK (Deflate::Adler32 ("") == 1);
+	CHECK (Deflate::Adler32 ("Wikipedia") == 0x11E60398);
+
+	// long enough for the sums to be reduced many times
+	const std::string bytes (1000000, '\xFF');
+	CHECK (Deflate::Adler32 (bytes) == adler32 (adler32 (0, nullptr, 0), (const Bytef*) bytes.data (), (uInt) bytes.size ()));
+}
+
+
+// the size and the encoding time of a typical response, for comparison with the plain JSON
+static void ReportRatio ()
+{
+	const std::string json = ElementsJson (10000);
+
+	const auto start = std::chrono::steady_clock::now ();
+	std::string compressed;
+	Deflate::Compress (json, compressed);
+	const std::string payload = Deflate::ToBase64 (compressed);
+	const auto end = std::chrono::steady_clock::now ();
+
+	printf ("%zu bytes of JSON, %zu bytes deflated (%.1f%%), %zu bytes of base64 (%.1f%%), encoded in %.2f ms\n",
+		json.size (), compressed.size (), 100.0 * compressed.size () / json.size (),
+		payload.size (), 100.0 * payload.size () / json.size (),
+		std::chrono::duration<double, std::milli> (end - start).count ());
+}
+
+
+int main ()
+{
+	TestRoundTrips ();
+	TestBase64 ();
+	TestAdler32 ();
+	ReportRatio ();
+
+	return TestUtility::Result ();
+}
@@ -0,0 +1,233 @@
+#include "Polyline.hpp"
+#include "ObjectState.hpp"
+#include "TestUtility.hpp"
+
+#include <vector>
+
+
+using namespace Objects;
+
+
+static Polyline Ring (const std::vector<API_Coord>& points, const std::vector<double>& arcAngles = {}, const std::vector<bool>& bodyFlags = {})
+{
+	GS::Array<PolylineSegment> segments;
+	for (size_t i = 0; i < points.size (); i++) {
+		const API_Coord& start = points[i];
+		const API_Coord& end = points[(i + 1) % points.size ()];
+		const double arcAngle = i < arcAngles.size () ? arcAngles[i] : 0.0;
+		GS::Optional<bool> bodyFlag = GS::NoValue;
+		if (i < bodyFlags.size ())
+			bodyFlag = bodyFlags[i];
+
+		segments.Push (PolylineSegment (Point3D (start, 0.0), Point3D (end, 0.0), arcAngle, bodyFlag));
+	}
+
+	return Polyline (segments);
+}
+
+
+static ElementShape Shape (const Polyline& contour, const GS::Array<Polyline>& holes = {})
+{
+	GS::ObjectState os;
+	os.Add ("contourPolyline", contour);
+	if (!holes.IsEmpty ())
+		os.Add ("holePolylines", holes);
+
+	ElementShape shape;
+	shape.Restore (os);
+
+	return shape;
+}
+
+
+static void KillMemo (API_ElementMemo& memo)
+{
+	BMhKill ((GSHandle*) &memo.coords);
+	BMhKill ((GSHandle*) &memo.pends);
+	BMhKill ((GSHandle*) &memo.parcs);
+	BMhKill ((GSHandle*) &memo.vertexIDs);
+	BMhKill ((GSHandle*) &memo.edgeIDs);
+	BMhKill ((GSHandle*) &memo.contourIDs);
+	BMhKill ((GSHandle*) &memo.additionalPolyCoords);
+	BMhKill ((GSHandle*) &memo.additionalPolyPends);
+	BMhKill ((GSHandle*) &memo.additionalPolyParcs);
+	BMhKill ((GSHandle*) &memo.additionalPolyVertexIDs);
+	BMhKill ((GSHandle*) &memo.additionalPolyEdgeIDs);
+	BMhKill ((GSHandle*) &memo.additionalPolyContourIDs);
+	for (API_ShellShapeData& shellShape : memo.shellShapes) {
+		BMhKill ((GSHandle*) &shellShape.coords);
+		BMhKill ((GSHandle*) &shellShape.pends);
+		BMhKill ((GSHandle*) &shellShape.parcs);
+		BMhKill ((GSHandle*) &shellShape.vertexIDs);
+		BMhKill ((GSHandle*) &shellShape.edgeIDs);
+		BMhKill ((GSHandle*) &shellShape.bodyFlags);
+	}
+}
+
+
+static const std::vector<API_Coord> Square = { { 0, 0 }, { 10, 0 }, { 10, 10 }, { 0, 10 } };
+static const std::vector<API_Coord> Hole = { { 2, 2 }, { 4, 2 }, { 4, 4 }, { 2, 4 } };
+
+
+// the subpolygons are closed, a vertex id is shared by the coordinates at the same place
+static void TestContourWithHole ()
+{
+	API_ElementMemo memo {};
+	Shape (Ring (Square, { 0, 0.5 }), { Ring (Hole) }).SetToMemo (memo, ElementShape::MemoMainPolygon);
+
+	CHECK ((*memo.pends)[0] == 0);
+	CHECK ((*memo.pends)[1] == 5);
+	CHECK ((*memo.pends)[2] == 10);
+
+	bool coordsMatch = true;
+	for (int i = 0; i < 5; i++) {
+		coordsMatch = coordsMatch && (*memo.coords)[i + 1].x == Square[i % 4].x && (*memo.coords)[i + 1].y == Square[i % 4].y;
+		coordsMatch = coordsMatch && (*memo.coords)[i + 6].x == Hole[i % 4].x && (*memo.coords)[i + 6].y == Hole[i % 4].y;
+	}
+	CHECK (coordsMatch);
+
+	const std::vector<UInt32> vertexIds = { 8, 1, 2, 3, 4, 1, 5, 6, 7, 8, 5 };
+	bool vertexIdsMatch = true;
+	for (size_t i = 0; i < vertexIds.size (); i++)
+		vertexIdsMatch = vertexIdsMatch && (*memo.vertexIDs)[i] == vertexIds[i];
+	CHECK (vertexIdsMatch);
+
+	CHECK ((*memo.parcs)[0].begIndex == 2);
+	CHECK ((*memo.parcs)[0].endIndex == 3);
+	CHECK ((*memo.parcs)[0].arcAngle == 0.5);
+	CHECK (BMGetHandleSize ((GSHandle) memo.parcs) == (Int32) sizeof (API_PolyArc));
+
+	KillMemo (memo);
+}
+
+
+// a hole touching the contour shares the vertex id of the touching corner, -0.0 and 0.0 are the same place
+static void TestSharedVertices ()
+{
+	const std::vector<API_Coord> touchingHole = { { -0.0, 0 }, { 3, 1 }, { 1, 3 } };
+
+	API_ElementMemo memo {};
+	Shape (Ring (Square), { Ring (touchingHole) }).SetToMemo (memo, ElementShape::MemoMainPolygon);
+
+	CHECK ((*memo.vertexIDs)[6] == 1);
+	CHECK ((*memo.vertexIDs)[7] == 5);
+	CHECK ((*memo.vertexIDs)[9] == 1);
+	CHECK ((*memo.vertexIDs)[0] == 6);
+
+	KillMemo (memo);
+}
+
+
+// the body flag of a segment is stored at its start coordinate
+static void TestShellBodyFlags ()
+{
+	API_ElementMemo memo {};
+	Shape (Ring (Square, {}, { true, false, true, false })).SetToMemo (memo, ElementShape::MemoShellPolygon2);
+
+	CHECK (memo.coords == nullptr);
+	CHECK (memo.shellShapes[0].coords == nullptr);
+	CHECK ((*memo.shellShapes[1].pends)[1] == 5);
+	CHECK ((*memo.shellShapes[1].bodyFlags)[1] == true);
+	CHECK ((*memo.shellShapes[1].bodyFlags)[2] == false);
+	CHECK ((*memo.shellShapes[1].bodyFlags)[3] == true);
+	CHECK ((*memo.shellShapes[1].bodyFlags)[4] == false);
+
+	KillMemo (memo);
+}
+
+
+static void TestAdditionalPolygon ()
+{
+	API_ElementMemo memo {};
+	Shape (Ring (Hole)).SetToMemo (memo, ElementShape::MemoAdditionalPolygon);
+
+	CHECK (memo.coords == nullptr);
+	CHECK ((*memo.additionalPolyPends)[1] == 5);
+	CHECK ((*memo.additionalPolyCoords)[3].x == 4);
+	CHECK ((*memo.additionalPolyVertexIDs)[5] == 1);
+
+	KillMemo (memo);
+}
+
+
+static void TestShellContour ()
+{
+	API_ShellContourData contours[2] {};
+	API_ElementMemo memo {};
+	memo.shellContours = contours;
+	Shape (Ring (Hole)).SetToMemo (memo, ElementShape::MemoShellContour, 1);
+
+	CHECK (contours[0].coords == nullptr);
+	CHECK ((*contours[1].pends)[1] == 5);
+	CHECK ((*contours[1].coords)[1].x == 2);
+
+	BMhKill ((GSHandle*) &contours[1].coords);
+	BMhKill ((GSHandle*) &contours[1].pends);
+	BMhKill ((GSHandle*) &contours[1].parcs);
+	BMhKill ((GSHandle*) &contours[1].vertexIDs);
+}
+
+
+// the handles of the memo are replaced, not leaked
+static void TestReplacedHandles ()
+{
+	API_ElementMemo memo {};
+	Shape (Ring (Square)).SetToMemo (memo, ElementShape::MemoMainPolygon);
+	const Int32 handleCount = StubACAPI::LiveHandleCount ();
+
+	Shape (Ring (Square), { Ring (Hole) }).SetToMemo (memo, ElementShape::MemoMainPolygon);
+	CHECK (StubACAPI::LiveHandleCount () == handleCount);
+	CHECK ((*memo.pends)[2] == 10);
+
+	KillMemo (memo);
+}
+
+
+// a shape read from a memo is written back into the same coordinates, arcs and vertex ids
+static void TestMemoRoundTrip ()
+{
+	API_ElementMemo source {};
+	Shape (Ring (Square, { 0, 0, -0.75 }), { Ring (Hole, { 0.25 }) }).SetToMemo (source, ElementShape::MemoMainPolygon);
+
+	API_Polygon polygon {};
+	polygon.nCoords = 10;
+	polygon.nSubPolys = 2;
+	polygon.nArcs = 2;
+	ElementShape shape (polygon, source, ElementShape::MemoMainPolygon);
+
+	API_ElementMemo target {};
+	shape.SetToMemo (target, ElementShape::MemoMainPolygon);
+
+	bool same = true;
+	for (int i = 0; i <= 10; i++) {
+		same = same && (*source.coords)[i].x == (*target.coords)[i].x && (*source.coords)[i].y == (*target.coords)[i].y;
+		same = same && (*source.vertexIDs)[i] == (*target.vertexIDs)[i];
+	}
+	for (int i = 0; i <= 2; i++)
+		same = same && (*source.pends)[i] == (*target.pends)[i];
+	for (int i = 0; i < 2; i++) {
+		same = same && (*source.parcs)[i].begIndex == (*target.parcs)[i].begIndex;
+		same = same && (*source.parcs)[i].endIndex == (*target.parcs)[i].endIndex;
+		same = same && (*source.parcs)[i].arcAngle == (*target.parcs)[i].arcAngle;
+	}
+	CHECK (same);
+
+	KillMemo (source);
+	KillMemo (target);
+}
+
+
+int main ()
+{
+	TestContourWithHole ();
+	TestSharedVertices ();
+	TestShellBodyFlags ();
+	TestAdditionalPolygon ();
+	TestShellContour ();
+	TestReplacedHandles ();
+	TestMemoRoundTrip ();
+
+	CHECK (StubACAPI::LiveHandleCount () == 0);
+
+	return TestUtility::Result ();
+}
@@ -0,0 +1,146 @@
+#include "GDLScriptWriter.hpp"
+#include "TestUtility.hpp"
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <string>
+
+
+static std::string FormatDouble (double value)
+{
+	std::string text;
+	GDLScriptWriter::AppendDouble (text, value);
+	return text;
+}
+
+
+static bool ReadsBack (double value)
+{
+	const std::string text = FormatDouble (value);
+	return strtod (text.c_str (), nullptr) == value;
+}
+
+
+static void TestNumberFormatting ()
+{
+	CHECK (FormatDouble (0.0) == "0");
+	CHECK (FormatDouble (-0.0) == "0");
+	CHECK (FormatDouble (3.0) == "3");
+	CHECK (FormatDouble (-12.0) == "-12");
+	CHECK (FormatDouble (0.5) == "0.5");
+	CHECK (FormatDouble (-2.25) == "-2.25");
+	CHECK (FormatDouble (std::numeric_limits<double>::quiet_NaN ()) == "0");
+	CHECK (FormatDouble (std::numeric_limits<double>::infinity ()) == "0");
+
+	CHECK (ReadsBack (0.1));
+	CHECK (ReadsBack (1.0 / 3.0));
+	CHECK (ReadsBack (-12.345678901234567));
+
+	// the small and the large values keep their exponent, a fixed notation would lose them
+	CHECK (FormatDouble (1e-7).find ('e') != std::string::npos);
+	CHECK (ReadsBack (1e-7));
+	CHECK (ReadsBack (-2.5e-12));
+	CHECK (ReadsBack (std::numeric_limits<double>::denorm_min ()));
+	CHECK (ReadsBack (1e15 + 0.5));
+	CHECK (ReadsBack (1e20));
+	CHECK (ReadsBack (-std::numeric_limits<double>::max ()));
+
+	std::mt19937_64 generator (7);
+	std::uniform_real_distribution<double> coordinates (-1e4, 1e4);
+	bool allReadBack = true;
+	for (int i = 0; i < 100000; i++)
+		allReadBack = allReadBack && ReadsBack (coordinates (generator));
+	CHECK (allReadBack);
+}
+
+
+// the writers of the generated scripts run in the locale of Archicad, the separator must stay a point
+static void TestNumberFormattingInCommaLocale ()
+{
+	const char* commaLocales[] = { "de_DE.UTF-8", "de_DE.utf8", "hu_HU.UTF-8", "fr_FR.UTF-8" };
+	for (const char* locale : commaLocales) {
+		if (setlocale (LC_NUMERIC, locale) == nullptr)
+			continue;
+
+		CHECK (FormatDouble (0.5) == "0.5");
+		CHECK (FormatDouble (1e-7).find (',') == std::string::npos);
+		setlocale (LC_NUMERIC, "C");
+		return;
+	}
+
+	printf ("no locale with a decimal comma is installed, skipped the locale check\n");
+}
+
+
+static void TestIntegerFormatting ()
+{
+	StubACAPI::ResetWrittenSections ();
+	{
+		GDLScriptWriter writer;
+		writer << (Int32) 0 << ' ' << (Int32) -42 << ' ' << std::numeric_limits<Int32>::min () << ' ' << std::numeric_limits<UInt32>::max ();
+	}
+
+	CHECK (StubACAPI::WrittenSections () == "0 -42 -2147483648 4294967295");
+}
+
+
+static void TestBuffering ()
+{
+	StubACAPI::ResetWrittenSections ();
+
+	std::string expected;
+	{
+		GDLScriptWriter writer (64);
+		for (Int32 i = 0; i < 100; i++) {
+			writer << "VERT " << 0.5 * i << ", " << i << ", " << GS::String ("0") << '\n';
+			expected += "VERT " + FormatDouble (0.5 * i) + ", " + std::to_string (i) + ", 0\n";
+		}
+
+		// the text is handed over in chunks of about the chunk size, not per call
+		CHECK (StubACAPI::WriteSectionCallCount () > 1);
+		CHECK (StubACAPI::WriteSectionCallCount () <= expected.size () / 64);
+	}
+
+	// the destructor writes the rest
+	CHECK (StubACAPI::WrittenSections () == expected);
+
+	// flushing an empty buffer writes nothing
+	StubACAPI::ResetWrittenSections ();
+	{
+		GDLScriptWriter writer;
+		CHECK (writer.Flush () == NoError);
+	}
+	CHECK (StubACAPI::WriteSectionCallCount () == 0);
+}
+
+
+static void TestWriteError ()
+{
+	StubACAPI::ResetWrittenSections ();
+	StubACAPI::FailWriteSection (APIERR_GENERAL);
+
+	GDLScriptWriter writer (16);
+	writer << "a text longer than the chunk size";
+	writer << "more text";
+
+	// the first error is kept, the later writes don't hide it
+	StubACAPI::FailWriteSection (NoError);
+	CHECK (writer.Flush () == APIERR_GENERAL);
+
+	StubACAPI::ResetWrittenSections ();
+}
+
+
+int main ()
+{
+	TestNumberFormatting ();
+	TestNumberFormattingInCommaLocale ();
+	TestIntegerFormatting ();
+	TestBuffering ();
+	TestWriteError ();
+
+	return TestUtility::Result ();
+}
@@ -0,0 +1,160 @@
+#include "Polyline.hpp"
+#include "ObjectState.hpp"
+#include "RealNumber.h"
+#include "TestUtility.hpp"
+
+#include <cmath>
+#include <vector>
+
+
+using namespace Objects;
+
+
+static GS::Array<PolylineSegment> Chain (const std::vector<Point3D>& points)
+{
+	GS::Array<PolylineSegment> segments;
+	for (size_t i = 0; i + 1 < points.size (); i++)
+		segments.Push (PolylineSegment (points[i], points[i + 1]));
+
+	return segments;
+}
+
+
+static bool HasVertices (const Polyline& polyline, const std::vector<Point3D>& points)
+{
+	if (polyline.VertexCount () != (int) points.size ())
+		return false;
+
+	for (size_t i = 0; i < points.size (); i++) {
+		if (!(*polyline.PointAt ((int) i) == points[i]))
+			return false;
+	}
+
+	return polyline.PointAt ((int) points.size ()) == nullptr;
+}
+
+
+static void TestVertices ()
+{
+	CHECK (Polyline ().VertexCount () == 0);
+	CHECK (Polyline (GS::Array<PolylineSegment> ()).VertexCount () == 0);
+
+	// an open chain has one more vertex than segments
+	const std::vector<Point3D> open = { Point3D (0, 0, 0), Point3D (1, 0, 0), Point3D (1, 1, 0), Point3D (2, 1, 0) };
+	CHECK (HasVertices (Polyline (Chain (open)), open));
+
+	// a closed contour ends with its first point repeated
+	const std::vector<Point3D> square = { Point3D (0, 0, 1), Point3D (1, 0, 1), Point3D (1, 1, 1), Point3D (0, 1, 1), Point3D (0, 0, 1) };
+	const Polyline closed (Chain (square));
+	CHECK (HasVertices (closed, square));
+	CHECK (closed.IsClosed ());
+
+	// the start point of a segment not continuing the previous one is a vertex of its own
+	GS::Array<PolylineSegment> gap;
+	gap.Push (PolylineSegment (Point3D (0, 0, 0), Point3D (1, 0, 0)));
+	gap.Push (PolylineSegment (Point3D (2, 0, 0), Point3D (3, 0, 0)));
+	CHECK (HasVertices (Polyline (gap), { Point3D (0, 0, 0), Point3D (1, 0, 0), Point3D (2, 0, 0), Point3D (3, 0, 0) }));
+
+	// the points within the tolerance continue the chain
+	GS::Array<PolylineSegment> nearlyContinuous;
+	nearlyContinuous.Push (PolylineSegment (Point3D (0, 0, 0), Point3D (1, 0, 0)));
+	nearlyContinuous.Push (PolylineSegment (Point3D (1 + EPS / 10, 0, 0), Point3D (2, 0, 0)));
+	CHECK (Polyline (nearlyContinuous).VertexCount () == 3);
+
+	// a chain passing a point twice keeps both passes
+	const std::vector<Point3D> figureEight = { Point3D (0, 0, 0), Point3D (1, 1, 0), Point3D (2, 0, 0), Point3D (1, -1, 0), Point3D (1, 1, 0), Point3D (0, 0, 0) };
+	CHECK (HasVertices (Polyline (Chain (figureEight)), figureEight));
+
+	std::vector<Point3D> circle;
+	for (int i = 0; i <= 100000; i++)
+		circle.push_back (Point3D (cos (2.0 * PI * i / 100000), sin (2.0 * PI * i / 100000), 0));
+	CHECK (Polyline (Chain (circle)).VertexCount () == 100001);
+}
+
+
+static void TestArcs ()
+{
+	GS::Array<PolylineSegment> segments;
+	segments.Push (PolylineSegment (Point3D (0, 0, 0), Point3D (1, 0, 0)));
+	segments.Push (PolylineSegment (Point3D (1, 0, 0), Point3D (1, 1, 0), PI / 2));
+	segments.Push (PolylineSegment (Point3D (1, 1, 0), Point3D (0, 1, 0)));
+	segments.Push (PolylineSegment (Point3D (0, 1, 0), Point3D (0, 0, 0), -PI / 4));
+	const Polyline polyline (segments);
+
+	CHECK (polyline.ArcCount () == 2);
+	CHECK (polyline.ArcAt (0)->arcAngle == PI / 2);
+	CHECK (polyline.ArcAt (1)->arcAngle == -PI / 4);
+	CHECK (polyline.ArcAt (2) == nullptr);
+	CHECK (polyline.SegmentAt (3)->endPoint == Point3D (0, 0, 0));
+	CHECK (polyline.SegmentAt (4) == nullptr);
+}
+
+
+// a restored polyline fills its vertices like a constructed one
+static void TestRestore ()
+{
+	const std::vector<Point3D> points = { Point3D (0, 0, 0), Point3D (3, 0, 0), Point3D (3, 4, 0), Point3D (0, 0, 0) };
+
+	GS::ObjectState os;
+	os.Add ("polyline", Polyline (Chain (points)));
+
+	Polyline restored;
+	CHECK (os.Get ("polyline", restored));
+	CHECK (HasVertices (restored, points));
+}
+
+
+// the arcs of a memo polygon belong to the segment starting at their begin index
+static void TestShapeArcs ()
+{
+	const std::vector<API_Coord> coords = { { 0, 0 }, { 0, 0 }, { 4, 0 }, { 4, 4 }, { 0, 4 }, { 0, 0 } };
+	const std::vector<API_PolyArc> arcs = { { 2, 3, 0.5 }, { 4, 5, -0.25 }, { 2, 3, 1.0 } };
+
+	API_ElementMemo memo {};
+	memo.coords = reinterpret_cast<API_Coord**> (BMAllocateHandle ((Int32) (coords.size () * sizeof (API_Coord)), ALLOCATE_CLEAR, 0));
+	memo.pends = reinterpret_cast<Int32**> (BMAllocateHandle (2 * sizeof (Int32), ALLOCATE_CLEAR, 0));
+	memo.parcs = reinterpret_cast<API_PolyArc**> (BMAllocateHandle ((Int32) (arcs.size () * sizeof (API_PolyArc)), ALLOCATE_CLEAR, 0));
+	for (size_t i = 0; i < coords.size (); i++)
+		(*memo.coords)[i] = coords[i];
+	for (size_t i = 0; i < arcs.size (); i++)
+		(*memo.parcs)[i] = arcs[i];
+	(*memo.pends)[1] = 5;
+
+	API_Polygon polygon {};
+	polygon.nCoords = 5;
+	polygon.nSubPolys = 1;
+	polygon.nArcs = (Int32) arcs.size ();
+
+	const ElementShape shape (polygon, memo, ElementShape::MemoMainPolygon, 2.5);
+	CHECK (shape.SubpolyCount () == 1);
+	CHECK (shape.VertexCount () == 5);
+	CHECK (shape.Level () == 2.5);
+
+	GS::ObjectState os;
+	shape.Store (os);
+	Polyline contour;
+	CHECK (os.Get ("contourPolyline", contour));
+
+	// the first arc of a begin index wins, like the scan of the arcs did
+	CHECK (contour.ArcCount () == 2);
+	CHECK (contour.SegmentAt (1)->arcAngle == 0.5);
+	CHECK (contour.SegmentAt (3)->arcAngle == -0.25);
+	CHECK (contour.SegmentAt (0)->arcAngle == 0);
+
+	BMhKill ((GSHandle*) &memo.coords);
+	BMhKill ((GSHandle*) &memo.pends);
+	BMhKill ((GSHandle*) &memo.parcs);
+}
+
+
+int main ()
+{
+	TestVertices ();
+	TestArcs ();
+	TestRestore ();
+	TestShapeArcs ();
+
+	CHECK (StubACAPI::LiveHandleCount () == 0);
+
+	return TestUtility::Result ();
+}
@@ -0,0 +1,314 @@
+#ifndef STUB_ACAPINC_H
+#define STUB_ACAPINC_H
+
+// The small part of the Archicad API and of the GS library the tested sources use, implemented on the standard library.
+// Only the behaviour the add-on relies on is reproduced, see StubACAPI.cpp for the recorded API calls.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#define ServerMainVers_2700 2700
+
+
+typedef int8_t		Int8;
+typedef uint8_t		UInt8;
+typedef int16_t		Int16;
+typedef uint16_t	UInt16;
+typedef int32_t		Int32;
+typedef uint32_t	UInt32;
+typedef uint32_t	ULong;
+typedef uint32_t	USize;
+typedef int32_t		GSErrCode;
+typedef char**		GSHandle;
+
+static const USize MaxUSize = UINT32_MAX;
+
+enum {
+	NoError = 0,
+	Error = -1,
+	APIERR_GENERAL = -2130313216,
+	APIERR_BADNAME = -2130313208
+};
+
+
+namespace GS {
+
+
+typedef int32_t		Int32;
+typedef uint32_t	UInt32;
+typedef int64_t		Int64;
+typedef uint64_t	UInt64;
+typedef ::USize		USize;
+
+class ObjectState;
+
+
+class String {
+public:
+	String () = default;
+	String (const char* text) : text (text) {}
+	String (const std::string& text) : text (text) {}
+
+	const char*	ToCStr () const { return text.c_str (); }
+	USize		GetLength () const { return (USize) text.size (); }
+
+	bool operator== (const String& other) const { return text == other.text; }
+	bool operator!= (const String& other) const { return text != other.text; }
+
+private:
+	std::string text;
+};
+
+
+class UniString {
+public:
+	UniString () = default;
+	UniString (const char* text) : text (text) {}
+	UniString (const std::string& text) : text (text) {}
+
+	const std::string&	ToStdString () const { return text; }
+	USize				GetLength () const { return (USize) text.size (); }
+	bool				IsEmpty () const { return text.empty (); }
+
+	bool operator== (const UniString& other) const { return text == other.text; }
+	bool operator!= (const UniString& other) const { return text != other.text; }
+
+private:
+	std::string text;
+};
+
+
+template <typename Type>
+class Array {
+public:
+	Array () = default;
+	Array (std::initializer_list<Type> items) : items (items) {}
+
+	void			Push (const Type& item) { items.push_back (item); }
+	void			Clear () { items.clear (); }
+	void			SetCapacity (USize capacity) { items.reserve (capacity); }
+
+	USize			GetSize () const { return (USize) items.size (); }
+	bool			IsEmpty () const { return items.empty (); }
+
+	const Type&		GetFirst () const { return items.front (); }
+	const Type&		GetLast () const { return items.back (); }
+
+	Type&			operator[] (UInt32 index) { return items[index]; }
+	const Type&		operator[] (UInt32 index) const { return items[index]; }
+
+	bool operator== (const Array& other) const { return items == other.items; }
+
+	typename std::vector<Type>::iterator		begin () { return items.begin (); }
+	typename std::vector<Type>::iterator		end () { return items.end (); }
+	typename std::vector<Type>::const_iterator	begin () const { return items.begin (); }
+	typename std::vector<Type>::const_iterator	end () const { return items.end (); }
+
+private:
+	std::vector<Type> items;
+};
+
+
+// the keys hash with their GenerateHashValue method if they have one, like with the GS hashers
+template <typename Key, typename = void>
+struct Hasher {
+	size_t operator() (const Key& key) const { return std::hash<Key> () (key); }
+};
+
+template <typename Key>
+struct Hasher<Key, std::void_t<decltype (std::declval<const Key&> ().GenerateHashValue ())>> {
+	size_t operator() (const Key& key) const { return key.GenerateHashValue (); }
+};
+
+
+template <typename Key, typename Value>
+class HashTable {
+public:
+	bool			Add (const Key& key, const Value& value) { return items.emplace (key, value).second; }
+	void			Put (const Key& key, const Value& value) { items[key] = value; }
+	bool			Delete (const Key& key) { return items.erase (key) > 0; }
+	void			Clear () { items.clear (); }
+
+	bool			ContainsKey (const Key& key) const { return items.find (key) != items.end (); }
+	USize			GetSize () const { return (USize) items.size (); }
+	bool			IsEmpty () const { return items.empty (); }
+
+	bool Get (const Key& key, Value* value) const
+	{
+		auto it = items.find (key);
+		if (it == items.end ())
+			return false;
+
+		*value = it->second;
+		return true;
+	}
+
+	Value* GetPtr (const Key& key)
+	{
+		auto it = items.find (key);
+		return it == items.end () ? nullptr : &it->second;
+	}
+
+	const Value* GetPtr (const Key& key) const
+	{
+		auto it = items.find (key);
+		return it == items.end () ? nullptr : &it->second;
+	}
+
+private:
+	std::unordered_map<Key, Value, Hasher<Key>> items;
+};
+
+
+template <typename Key>
+class HashSet {
+public:
+	bool			Add (const Key& key) { return items.insert (key).second; }
+	bool			Delete (const Key& key) { return items.erase (key) > 0; }
+	void			Clear () { items.clear (); }
+
+	bool			Contains (const Key& key) const { return items.find (key) != items.end (); }
+	USize			GetSize () const { return (USize) items.size (); }
+	bool			IsEmpty () const { return items.empty (); }
+
+private:
+	std::unordered_set<Key, Hasher<Key>> items;
+};
+
+
+struct NoValueSelector {};
+static const NoValueSelector NoValue;
+
+
+template <typename Type>
+class Optional {
+public:
+	Optional () = default;
+	Optional (NoValueSelector) {}
+	Optional (const Type& value) : value (value) {}
+
+	bool			HasValue () const { return value.has_value (); }
+	const Type&		Get () const { return *value; }
+
+private:
+	std::optional<Type> value;
+};
+
+
+}
+
+
+struct API_Coord {
+	double x;
+	double y;
+};
+
+
+struct API_Coord3D {
+	double x;
+	double y;
+	double z;
+};
+
+
+struct API_PolyArc {
+	Int32	begIndex;
+	Int32	endIndex;
+	double	arcAngle;
+};
+
+
+struct API_Polygon {
+	Int32	nCoords;
+	Int32	nSubPolys;
+	Int32	nArcs;
+};
+
+
+struct API_ShellShapeData {
+	API_Coord**		coords;
+	Int32**			pends;
+	API_PolyArc**	parcs;
+	UInt32**		vertexIDs;
+	UInt32**		edgeIDs;
+	bool**			bodyFlags;
+};
+
+
+struct API_ShellContourData {
+	API_Coord**		coords;
+	Int32**			pends;
+	API_PolyArc**	parcs;
+	UInt32**		vertexIDs;
+	UInt32**		edgeIDs;
+	UInt32**		contourIDs;
+};
+
+
+struct API_ElementMemo {
+	API_Coord**				coords;
+	Int32**					pends;
+	API_PolyArc**			parcs;
+	UInt32**				vertexIDs;
+	UInt32**				edgeIDs;
+	UInt32**				contourIDs;
+
+	API_Coord**				additionalPolyCoords;
+	Int32**					additionalPolyPends;
+	API_PolyArc**			additionalPolyParcs;
+	UInt32**				additionalPolyVertexIDs;
+	UInt32**				additionalPolyEdgeIDs;
+	UInt32**				additionalPolyContourIDs;
+
+	API_ShellShapeData		shellShapes[2];
+	API_ShellContourData*	shellContours;
+};
+
+
+// memory manager, the handles are counted so the tests can check that none of them leak
+#define ALLOCATE_CLEAR 1
+
+GSHandle	BMAllocateHandle (Int32 size, Int32 flags, Int32 reserved);
+void		BMhKill (GSHandle* handle);
+Int32		BMGetHandleSize (GSHandle handle);
+
+// library parts, the written sections are collected by the stub
+GSErrCode	ACAPI_LibraryPart_WriteSection (Int32 size, const char* text);
+
+// bodies, the body data is a StubACAPI::Body, only the edges are recorded
+GSErrCode	ACAPI_Body_AddEdge (void* bodyData, const UInt32 vertex1, const UInt32 vertex2, Int32& index);
+
+
+namespace StubACAPI {
+
+
+struct BodyEdge {
+	UInt32 vertex1;
+	UInt32 vertex2;
+};
+
+// the edge indices start at 1, a negative index is the edge in reverse
+struct Body {
+	std::vector<BodyEdge> edges;
+};
+
+Int32				LiveHandleCount ();
+
+const std::string&	WrittenSections ();
+UInt32				WriteSectionCallCount ();
+void				ResetWrittenSections ();
+void				FailWriteSection (GSErrCode err);
+
+
+}
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef STUB_JAVASCRIPT_ENGINE_HPP
+#define STUB_JAVASCRIPT_ENGINE_HPP
+
+// APIMigrationHelper.hpp includes it for the JSON type names, none of the tested sources use them
+
+#endif
@@ -0,0 +1,122 @@
+#ifndef STUB_OBJECT_STATE_HPP
+#define STUB_OBJECT_STATE_HPP
+
+#include "ACAPinc.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+namespace GS {
+
+
+/*!
+ Tree of named values like the GS object state, the objects are added and read back with their Store and Restore methods
+ */
+class ObjectState {
+private:
+	struct Value {
+		enum Kind { Number, Boolean, Text, Object, List };
+
+		Kind							kind = Number;
+		double							number = 0.0;
+		bool							boolean = false;
+		std::string						text;
+		std::shared_ptr<ObjectState>	object;
+		std::vector<Value>				list;
+	};
+
+	template <typename Type>
+	struct IsArray : std::false_type {};
+
+	template <typename Type>
+	struct IsArray<Array<Type>> : std::true_type {};
+
+	template <typename Type>
+	static Value ToValue (const Type& item)
+	{
+		Value value;
+		if constexpr (std::is_same_v<Type, bool>) {
+			value.kind = Value::Boolean;
+			value.boolean = item;
+		} else if constexpr (std::is_arithmetic_v<Type>) {
+			value.kind = Value::Number;
+			value.number = static_cast<double> (item);
+		} else if constexpr (std::is_same_v<Type, UniString>) {
+			value.kind = Value::Text;
+			value.text = item.ToStdString ();
+		} else if constexpr (IsArray<Type>::value) {
+			value.kind = Value::List;
+			for (const auto& listItem : item)
+				value.list.push_back (ToValue (listItem));
+		} else {
+			value.kind = Value::Object;
+			value.object = std::make_shared<ObjectState> ();
+			item.Store (*value.object);
+		}
+
+		return value;
+	}
+
+	template <typename Type>
+	static bool FromValue (const Value& value, Type& item)
+	{
+		if constexpr (std::is_same_v<Type, bool>) {
+			if (value.kind != Value::Boolean)
+				return false;
+			item = value.boolean;
+		} else if constexpr (std::is_arithmetic_v<Type>) {
+			if (value.kind != Value::Number)
+				return false;
+			item = static_cast<Type> (value.number);
+		} else if constexpr (std::is_same_v<Type, UniString>) {
+			if (value.kind != Value::Text)
+				return false;
+			item = UniString (value.text);
+		} else if constexpr (IsArray<Type>::value) {
+			if (value.kind != Value::List)
+				return false;
+			item.Clear ();
+			for (const Value& listValue : value.list) {
+				typename std::remove_reference_t<decltype (*item.begin ())> listItem {};
+				if (!FromValue (listValue, listItem))
+					return false;
+				item.Push (listItem);
+			}
+		} else {
+			if (value.kind != Value::Object)
+				return false;
+			return item.Restore (*value.object) == NoError;
+		}
+
+		return true;
+	}
+
+	std::map<std::string, Value> fields;
+
+public:
+	template <typename Type>
+	bool Add (const std::string& name, const Type& item)
+	{
+		fields[name] = ToValue (item);
+		return true;
+	}
+
+	template <typename Type>
+	bool Get (const std::string& name, Type& item) const
+	{
+		auto it = fields.find (name);
+		return it != fields.end () && FromValue (it->second, item);
+	}
+
+	bool Contains (const std::string& name) const { return fields.find (name) != fields.end (); }
+	bool IsEmpty () const { return fields.empty (); }
+};
+
+
+}
+
+#endif
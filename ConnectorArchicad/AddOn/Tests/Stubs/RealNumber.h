@@ -0,0 +1,8 @@
+#ifndef STUB_REAL_NUMBER_H
+#define STUB_REAL_NUMBER_H
+
+// the tolerances of the GS geometry library
+static const double PI = 3.14159265358979323846;
+static const double EPS = 1E-5;
+
+#endif
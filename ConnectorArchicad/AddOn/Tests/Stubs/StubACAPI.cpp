@@ -0,0 +1,114 @@
+#include "ACAPinc.h"
+
+#include <cstdlib>
+#include <cstring>
+
+
+namespace {
+
+// a handle points to the pointer of its cleared block, the size is kept next to it
+struct HandleBlock {
+	char*	data;
+	Int32	size;
+};
+
+Int32 liveHandleCount = 0;
+
+std::string writtenSections;
+UInt32 writeSectionCallCount = 0;
+GSErrCode writeSectionError = NoError;
+
+}
+
+
+GSHandle BMAllocateHandle (Int32 size, Int32 /*flags*/, Int32 /*reserved*/)
+{
+	HandleBlock* block = new HandleBlock;
+	block->data = static_cast<char*> (calloc (size > 0 ? size : 1, 1));
+	block->size = size;
+	++liveHandleCount;
+
+	return &block->data;
+}
+
+
+void BMhKill (GSHandle* handle)
+{
+	if (handle == nullptr || *handle == nullptr)
+		return;
+
+	HandleBlock* block = reinterpret_cast<HandleBlock*> (*handle);
+	free (block->data);
+	delete block;
+	--liveHandleCount;
+
+	*handle = nullptr;
+}
+
+
+Int32 BMGetHandleSize (GSHandle handle)
+{
+	return handle == nullptr ? 0 : reinterpret_cast<HandleBlock*> (handle)->size;
+}
+
+
+GSErrCode ACAPI_LibraryPart_WriteSection (Int32 size, const char* text)
+{
+	++writeSectionCallCount;
+	if (writeSectionError != NoError)
+		return writeSectionError;
+
+	writtenSections.append (text, size);
+	return NoError;
+}
+
+
+GSErrCode ACAPI_Body_AddEdge (void* bodyData, const UInt32 vertex1, const UInt32 vertex2, Int32& index)
+{
+	if (bodyData == nullptr)
+		return APIERR_GENERAL;
+
+	StubACAPI::Body* body = static_cast<StubACAPI::Body*> (bodyData);
+	body->edges.push_back ({ vertex1, vertex2 });
+	index = (Int32) body->edges.size ();
+
+	return NoError;
+}
+
+
+namespace StubACAPI {
+
+
+Int32 LiveHandleCount ()
+{
+	return liveHandleCount;
+}
+
+
+const std::string& WrittenSections ()
+{
+	return writtenSections;
+}
+
+
+UInt32 WriteSectionCallCount ()
+{
+	return writeSectionCallCount;
+}
+
+
+void ResetWrittenSections ()
+{
+	writtenSections.clear ();
+	writeSectionCallCount = 0;
+	writeSectionError = NoError;
+}
+
+
+void FailWriteSection (GSErrCode err)
+{
+	writeSectionError = err;
+}
+
+
+}
@@ -0,0 +1,39 @@
+#ifndef TEST_UTILITY_HPP
+#define TEST_UTILITY_HPP
+
+#include <cstdio>
+#include <cstdlib>
+
+
+// the checks of a test executable, a failed check is reported and the executable fails at the end
+namespace TestUtility {
+
+
+inline int& FailureCount ()
+{
+	static int failureCount = 0;
+	return failureCount;
+}
+
+
+inline int Result ()
+{
+	if (FailureCount () > 0)
+		printf ("%d check(s) failed\n", FailureCount ());
+
+	return FailureCount () == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+}
+
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf ("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++TestUtility::FailureCount (); \
+		} \
+	} while (false)
+
+#endif
@@ -0,0 +1,25 @@
+using System.Threading.Tasks;
+using Speckle.Newtonsoft.Json;
+
+namespace Archicad.Communication.Commands;
+
+/// <summary>
+/// Polled by a connector started hidden, the first call tells the add-on that the connector is ready.
+/// </summary>
+internal sealed class ConnectorHeartbeat : ICommand<ConnectorHeartbeat.Result>
+{
+  [JsonObject(MemberSerialization.OptIn)]
+  public sealed class Parameters { }
+
+  [JsonObject(MemberSerialization.OptIn)]
+  public sealed class Result
+  {
+    [JsonProperty("show")]
+    public bool Show { get; private set; }
+  }
+
+  public async Task<Result> Execute()
+  {
+    return await HttpCommandExecutor.Execute<Parameters, Result>("ConnectorHeartbeat", new Parameters());
+  }
+}
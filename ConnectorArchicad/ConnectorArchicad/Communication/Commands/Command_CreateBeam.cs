@@ -20,13 +20,6 @@ internal sealed class CreateBeam : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadBeam> Datas { get; }
 
   public CreateBeam(IEnumerable<ArchicadBeam> datas)
@@ -42,7 +35,10 @@ internal sealed class CreateBeam : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateBeam", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateBeam",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
@@ -20,13 +20,6 @@ internal sealed class CreateColumn : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadColumn> Datas { get; }
 
   public CreateColumn(IEnumerable<ArchicadColumn> datas)
@@ -42,7 +35,10 @@ internal sealed class CreateColumn : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateColumn", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateColumn",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
@@ -20,13 +20,6 @@ internal sealed class CreateDirectShape : ICommand<IEnumerable<ApplicationObject
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<DirectShape> DirectShapes { get; }
 
   public CreateDirectShape(IEnumerable<DirectShape> directShapes)
@@ -41,10 +34,10 @@ internal sealed class CreateDirectShape : ICommand<IEnumerable<ApplicationObject
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>(
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
       "CreateDirectShape",
       new Parameters(DirectShapes)
     );
-    return result == null ? null : result.ApplicationObjects;
+    return result?.GetApplicationObjects();
   }
 }
@@ -20,13 +20,6 @@ internal sealed class CreateDoor : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadDoor> Datas { get; }
 
   public CreateDoor(IEnumerable<ArchicadDoor> datas)
@@ -36,7 +29,10 @@ internal sealed class CreateDoor : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateDoor", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateDoor",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
@@ -20,13 +20,6 @@ internal sealed class CreateFloor : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadFloor> Datas { get; }
 
   public CreateFloor(IEnumerable<ArchicadFloor> datas)
@@ -36,7 +29,10 @@ internal sealed class CreateFloor : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    Result result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateSlab", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateSlab",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
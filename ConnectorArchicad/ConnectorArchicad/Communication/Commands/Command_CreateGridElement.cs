@@ -19,13 +19,6 @@ internal sealed class CreateGridElement : ICommand<IEnumerable<ApplicationObject
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<Archicad.GridElement> Datas { get; }
 
   public CreateGridElement(IEnumerable<Archicad.GridElement> datas)
@@ -35,7 +28,10 @@ internal sealed class CreateGridElement : ICommand<IEnumerable<ApplicationObject
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateGridElement", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateGridElement",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
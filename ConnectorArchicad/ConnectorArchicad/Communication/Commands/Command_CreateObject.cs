@@ -24,13 +24,6 @@ internal sealed class CreateObject : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadObject> Objects { get; }
   private IEnumerable<MeshModel> MeshModels { get; }
 
@@ -42,10 +35,10 @@ internal sealed class CreateObject : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>(
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
       "CreateObject",
       new Parameters(Objects, MeshModels)
     );
-    return result == null ? null : result.ApplicationObjects;
+    return result?.GetApplicationObjects();
   }
 }
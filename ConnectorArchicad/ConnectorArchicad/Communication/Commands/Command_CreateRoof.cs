@@ -20,13 +20,6 @@ internal sealed class CreateRoof : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadRoof> Roofs { get; }
 
   public CreateRoof(IEnumerable<ArchicadRoof> roofs)
@@ -41,7 +34,10 @@ internal sealed class CreateRoof : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateRoof", new Parameters(Roofs));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateRoof",
+      new Parameters(Roofs)
+    );
+    return result?.GetApplicationObjects();
   }
 }
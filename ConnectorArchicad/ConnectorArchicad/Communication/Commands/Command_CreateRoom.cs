@@ -19,13 +19,6 @@ internal sealed class CreateRoom : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<Archicad.Room> Datas { get; }
 
   public CreateRoom(IEnumerable<Archicad.Room> datas)
@@ -35,7 +28,10 @@ internal sealed class CreateRoom : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    Result result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateZone", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateZone",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
@@ -20,13 +20,6 @@ internal sealed class CreateShell : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadShell> Shells { get; }
 
   public CreateShell(IEnumerable<ArchicadShell> shells)
@@ -41,7 +34,10 @@ internal sealed class CreateShell : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateShell", new Parameters(Shells));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateShell",
+      new Parameters(Shells)
+    );
+    return result?.GetApplicationObjects();
   }
 }
@@ -20,13 +20,6 @@ internal sealed class CreateSkylight : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadSkylight> Datas { get; }
 
   public CreateSkylight(IEnumerable<ArchicadSkylight> datas)
@@ -36,7 +29,10 @@ internal sealed class CreateSkylight : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateSkylight", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateSkylight",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
@@ -20,13 +20,6 @@ internal sealed class CreateWindow : ICommand<IEnumerable<ApplicationObject>>
     }
   }
 
-  [JsonObject(MemberSerialization.OptIn)]
-  private sealed class Result
-  {
-    [JsonProperty("applicationObjects")]
-    public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
-  }
-
   private IEnumerable<ArchicadWindow> Datas { get; }
 
   public CreateWindow(IEnumerable<ArchicadWindow> datas)
@@ -36,7 +29,10 @@ internal sealed class CreateWindow : ICommand<IEnumerable<ApplicationObject>>
 
   public async Task<IEnumerable<ApplicationObject>> Execute()
   {
-    var result = await HttpCommandExecutor.Execute<Parameters, Result>("CreateWindow", new Parameters(Datas));
-    return result == null ? null : result.ApplicationObjects;
+    var result = await HttpCommandExecutor.Execute<Parameters, CreateCommandResult>(
+      "CreateWindow",
+      new Parameters(Datas)
+    );
+    return result?.GetApplicationObjects();
   }
 }
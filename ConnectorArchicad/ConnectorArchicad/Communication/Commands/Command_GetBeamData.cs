@@ -13,9 +13,9 @@ internal sealed class GetBeamData : GetDataBase, ICommand<Speckle.Newtonsoft.Jso
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetBeamData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["beams"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "beams");
   }
 }
@@ -0,0 +1,98 @@
+using System.Collections.Generic;
+using System.Threading.Tasks;
+using Speckle.Newtonsoft.Json;
+
+namespace Archicad.Communication.Commands;
+
+/// <summary>
+/// Gets the elements created, modified and deleted since a sequence of the change journal of the add-on.
+/// The first call starts the journal, it reports an overflow until then.
+/// </summary>
+internal sealed class GetChangesSince : ICommand<GetChangesSince.Result>
+{
+  #region --- Classes ---
+
+  [JsonObject(MemberSerialization.OptIn)]
+  public sealed class Parameters
+  {
+    #region --- Fields ---
+
+    [JsonProperty("journalId")]
+    private string JournalId { get; }
+
+    [JsonProperty("sequence")]
+    private ulong Sequence { get; }
+
+    #endregion
+
+    #region --- Ctor \ Dtor ---
+
+    public Parameters(string journalId, ulong sequence)
+    {
+      JournalId = journalId;
+      Sequence = sequence;
+    }
+
+    #endregion
+  }
+
+  [JsonObject(MemberSerialization.OptIn)]
+  public sealed class Result
+  {
+    #region --- Fields ---
+
+    [JsonProperty("journalId")]
+    public string JournalId { get; private set; }
+
+    [JsonProperty("sequence")]
+    public ulong Sequence { get; private set; }
+
+    /// <summary>
+    /// The changes since the sequence are not known, everything has to be sent again.
+    /// </summary>
+    [JsonProperty("overflow")]
+    public bool Overflow { get; private set; }
+
+    [JsonProperty("created")]
+    public IEnumerable<string> Created { get; private set; } = new List<string>();
+
+    [JsonProperty("modified")]
+    public IEnumerable<string> Modified { get; private set; } = new List<string>();
+
+    [JsonProperty("deleted")]
+    public IEnumerable<string> Deleted { get; private set; } = new List<string>();
+
+    #endregion
+  }
+
+  #endregion
+
+  #region --- Fields ---
+
+  private string JournalId { get; }
+  private ulong Sequence { get; }
+
+  #endregion
+
+  #region --- Ctor \ Dtor ---
+
+  public GetChangesSince(string journalId, ulong sequence)
+  {
+    JournalId = journalId;
+    Sequence = sequence;
+  }
+
+  #endregion
+
+  #region --- Functions ---
+
+  public async Task<Result> Execute()
+  {
+    return await HttpCommandExecutor.Execute<Parameters, Result>(
+      "GetChangesSince",
+      new Parameters(JournalId, Sequence)
+    );
+  }
+
+  #endregion
+}
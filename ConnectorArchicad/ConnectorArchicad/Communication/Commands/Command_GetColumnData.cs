@@ -13,9 +13,9 @@ internal sealed class GetColumnData : GetDataBase, ICommand<Speckle.Newtonsoft.J
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetColumnData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["columns"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "columns");
   }
 }
@@ -1,12 +1,14 @@
 using System.Collections.Generic;
+using Archicad.Communication;
 using Speckle.Newtonsoft.Json;
+using Speckle.Newtonsoft.Json.Linq;
 
 namespace ConnectorArchicad.Communication.Commands;
 
 internal class GetDataBase
 {
   [JsonObject(MemberSerialization.OptIn)]
-  internal class Parameters
+  internal class Parameters : IEncodedResponseParameters
   {
     [JsonProperty("applicationIds")]
     protected IEnumerable<string> ApplicationIds { get; }
@@ -17,11 +19,23 @@ internal class GetDataBase
     [JsonProperty("sendListingParameters")]
     protected bool SendListingParameters { get; }
 
-    public Parameters(IEnumerable<string> applicationIds, bool sendProperties, bool sendListingParameters)
+    [JsonProperty("responseEncoding")]
+    public string ResponseEncoding { get; } = EncodedResponse.Deflate;
+
+    [JsonProperty("useDictionaries")]
+    protected bool UseDictionaries { get; }
+
+    public Parameters(
+      IEnumerable<string> applicationIds,
+      bool sendProperties,
+      bool sendListingParameters,
+      bool useDictionaries = false
+    )
     {
       ApplicationIds = applicationIds;
       SendProperties = sendProperties;
       SendListingParameters = sendListingParameters;
+      UseDictionaries = useDictionaries;
     }
   }
 
@@ -35,4 +49,88 @@ internal class GetDataBase
     SendProperties = sendProperties;
     SendListingParameters = sendListingParameters;
   }
+
+  /// <summary>
+  /// Replaces the table indices of a dictionary encoded response with the values of the tables,
+  /// so the elements look the same as in a plain response.
+  /// The indices come in their own fields (levelIndex, layerIndex, materialIndex, nameIndex), they are never guessed from a number value.
+  /// </summary>
+  protected static JArray ExpandDictionaries(JObject result, string fieldName)
+  {
+    JArray elements = (JArray)result[fieldName];
+    if (elements == null || result["dictionaries"] is not JObject dictionaries)
+    {
+      return elements;
+    }
+
+    JArray levels = (JArray)dictionaries["levels"];
+    JArray layers = (JArray)dictionaries["layers"];
+    JArray materials = (JArray)dictionaries["materials"];
+    JArray propertyGroups = (JArray)dictionaries["propertyGroups"];
+    JArray propertyNames = (JArray)dictionaries["propertyNames"];
+
+    foreach (JObject element in elements.Children<JObject>())
+    {
+      ExpandIndex(element, "levelIndex", "level", levels);
+      ExpandIndex(element, "layerIndex", "layer", layers);
+
+      if (element["materialQuantities"] is JArray materialQuantities)
+      {
+        foreach (JObject materialQuantity in materialQuantities.Children<JObject>())
+        {
+          if (materialQuantity["materialIndex"] is JToken materialIndex)
+          {
+            materialQuantity.Remove("materialIndex");
+            materialQuantity["material"] = new JObject { ["name"] = materials[(int)materialIndex] };
+          }
+        }
+      }
+
+      ExpandPropertyGroups(element["elementProperties"] as JArray, propertyGroups, propertyNames);
+
+      if (element["componentProperties"] is JArray componentProperties)
+      {
+        foreach (JObject component in componentProperties.Children<JObject>())
+        {
+          ExpandPropertyGroups(component["propertyGroups"] as JArray, propertyGroups, propertyNames);
+        }
+      }
+    }
+
+    return elements;
+  }
+
+  private static void ExpandPropertyGroups(JArray groups, JArray propertyGroups, JArray propertyNames)
+  {
+    if (groups == null)
+    {
+      return;
+    }
+
+    foreach (JObject group in groups.Children<JObject>())
+    {
+      ExpandIndex(group, "nameIndex", "name", propertyGroups);
+
+      if (group["propertyList"] is JArray properties)
+      {
+        foreach (JObject property in properties.Children<JObject>())
+        {
+          ExpandIndex(property, "nameIndex", "name", propertyNames);
+        }
+      }
+    }
+  }
+
+  private static void ExpandIndex(JObject obj, string indexFieldName, string fieldName, JArray table)
+  {
+    JToken index = obj[indexFieldName];
+    if (index == null)
+    {
+      return;
+    }
+
+    obj.Remove(indexFieldName);
+    // a token of the table is copied when it gets a second parent
+    obj[fieldName] = table[(int)index];
+  }
 }
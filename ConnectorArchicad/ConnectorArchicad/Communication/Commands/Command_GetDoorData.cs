@@ -13,9 +13,9 @@ internal sealed class GetDoorData : GetDataBase, ICommand<Speckle.Newtonsoft.Jso
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetDoorData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["doors"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "doors");
   }
 }
@@ -22,9 +22,9 @@ internal sealed class GetElementBaseData : GetDataBase, ICommand<Speckle.Newtons
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetElementBaseData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["elements"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "elements");
   }
 }
@@ -1,7 +1,10 @@
+using System;
 using System.Collections.Generic;
+using System.Linq;
 using System.Threading.Tasks;
 using Speckle.Newtonsoft.Json;
 using Speckle.Newtonsoft.Json.Converters;
+using Speckle.Newtonsoft.Json.Linq;
 
 namespace Archicad.Communication.Commands;
 
@@ -27,14 +30,30 @@ internal sealed class GetElementIds : ICommand<IEnumerable<string>>
 
     [JsonProperty("filterBy")]
     private List<string>? FilterBy { get; }
+
+    [JsonProperty("groupByType")]
+    private bool GroupByType { get; }
+
+    /// <summary>
+    /// Tested by the add-on on the listed elements, e.g. { "layers": [ "Structural - Bearing" ] }.
+    /// </summary>
+    [JsonProperty("filterExpression")]
+    private JObject? FilterExpression { get; }
     #endregion
 
     #region --- Ctor \ Dtor ---
 
-    public Parameters(ElementFilter filter, List<string>? filterBy = null)
+    public Parameters(
+      ElementFilter filter,
+      List<string>? filterBy = null,
+      bool groupByType = false,
+      JObject? filterExpression = null
+    )
     {
       Filter = filter;
       FilterBy = filterBy;
+      GroupByType = groupByType;
+      FilterExpression = filterExpression;
     }
 
     #endregion
@@ -45,6 +64,9 @@ internal sealed class GetElementIds : ICommand<IEnumerable<string>>
   {
     #region --- Fields ---
 
+    [JsonProperty("filterExpressionError")]
+    public int? FilterExpressionError { get; private set; }
+
     [JsonProperty("applicationIds")]
     public IEnumerable<string> ApplicationIds { get; private set; }
 
@@ -78,7 +100,12 @@ internal sealed class GetElementIds : ICommand<IEnumerable<string>>
       "GetElementIds",
       new Parameters(Filter, FilterBy)
     );
-    return result.ApplicationIds;
+    if (result.FilterExpressionError != null)
+    {
+      throw new InvalidOperationException($"The element filter could not be parsed (error {result.FilterExpressionError}).");
+    }
+
+    return result.ApplicationIds ?? Enumerable.Empty<string>();
   }
 
   #endregion
@@ -0,0 +1,84 @@
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading.Tasks;
+using Speckle.Newtonsoft.Json;
+using Speckle.Newtonsoft.Json.Linq;
+
+namespace Archicad.Communication.Commands;
+
+/// <summary>
+/// Lists the element ids like <see cref="GetElementIds"/>, grouped by element type in the same call.
+/// </summary>
+internal sealed class GetElementIdsByType : ICommand<Dictionary<string, IEnumerable<string>>>
+{
+  #region --- Classes ---
+
+  [JsonObject(MemberSerialization.OptIn)]
+  private sealed class Result
+  {
+    #region --- Fields ---
+
+    [JsonProperty("filterExpressionError")]
+    public int? FilterExpressionError { get; private set; }
+
+    [JsonProperty("elementTypes")]
+    public IEnumerable<TypeGroup> ElementTypes { get; private set; }
+
+    #endregion
+  }
+
+  [JsonObject(MemberSerialization.OptIn)]
+  private sealed class TypeGroup
+  {
+    [JsonProperty("elementType")]
+    public string ElementType { get; private set; }
+
+    [JsonProperty("applicationIds")]
+    public IEnumerable<string> ApplicationIds { get; private set; }
+  }
+
+  #endregion
+
+  #region --- Fields ---
+
+  private GetElementIds.ElementFilter Filter { get; }
+  private List<string>? FilterBy { get; }
+  private JObject? FilterExpression { get; }
+
+  #endregion
+
+  #region --- Ctor \ Dtor ---
+
+  public GetElementIdsByType(
+    GetElementIds.ElementFilter filter,
+    List<string>? filterBy = null,
+    JObject? filterExpression = null
+  )
+  {
+    Filter = filter;
+    FilterBy = filterBy;
+    FilterExpression = filterExpression;
+  }
+
+  #endregion
+
+  #region --- Functions ---
+
+  public async Task<Dictionary<string, IEnumerable<string>>> Execute()
+  {
+    Result result = await HttpCommandExecutor.Execute<GetElementIds.Parameters, Result>(
+      "GetElementIds",
+      new GetElementIds.Parameters(Filter, FilterBy, true, FilterExpression)
+    );
+    if (result.FilterExpressionError != null)
+    {
+      throw new InvalidOperationException($"The element filter could not be parsed (error {result.FilterExpressionError}).");
+    }
+
+    return result.ElementTypes?.ToDictionary(group => group.ElementType, group => group.ApplicationIds)
+      ?? new Dictionary<string, IEnumerable<string>>();
+  }
+
+  #endregion
+}
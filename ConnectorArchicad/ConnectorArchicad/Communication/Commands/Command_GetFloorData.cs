@@ -13,9 +13,9 @@ internal sealed class GetFloorData : GetDataBase, ICommand<Speckle.Newtonsoft.Js
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetSlabData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["slabs"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "slabs");
   }
 }
@@ -7,11 +7,14 @@ namespace Archicad.Communication.Commands;
 internal sealed class GetModelForElements : ICommand<IEnumerable<Model.ElementModelData>>
 {
   [JsonObject(MemberSerialization.OptIn)]
-  public sealed class Parameters
+  public sealed class Parameters : IEncodedResponseParameters
   {
     [JsonProperty("applicationIds")]
     private IEnumerable<string> ApplicationIds { get; }
 
+    [JsonProperty("responseEncoding")]
+    public string ResponseEncoding { get; } = EncodedResponse.Deflate;
+
     public Parameters(IEnumerable<string> applicationIds)
     {
       ApplicationIds = applicationIds;
@@ -13,9 +13,9 @@ internal sealed class GetOpeningData : GetDataBase, ICommand<Speckle.Newtonsoft.
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetOpeningData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["openings"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "openings");
   }
 }
@@ -13,9 +13,9 @@ internal sealed class GetRoofData : GetDataBase, ICommand<Speckle.Newtonsoft.Jso
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetRoofData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["roofs"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "roofs");
   }
 }
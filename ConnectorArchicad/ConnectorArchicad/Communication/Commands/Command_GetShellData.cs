@@ -13,9 +13,9 @@ internal sealed class GetShellData : GetDataBase, ICommand<Speckle.Newtonsoft.Js
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetShellData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["shells"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "shells");
   }
 }
@@ -13,9 +13,9 @@ internal sealed class GetSkylightData : GetDataBase, ICommand<Speckle.Newtonsoft
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetSkylightData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["skylights"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "skylights");
   }
 }
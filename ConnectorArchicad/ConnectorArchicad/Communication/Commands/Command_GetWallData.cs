@@ -13,9 +13,9 @@ internal sealed class GetWallData : GetDataBase, ICommand<Speckle.Newtonsoft.Jso
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetWallData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["walls"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "walls");
   }
 }
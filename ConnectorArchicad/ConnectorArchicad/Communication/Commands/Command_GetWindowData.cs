@@ -13,9 +13,9 @@ internal sealed class GetWindowData : GetDataBase, ICommand<Speckle.Newtonsoft.J
   {
     dynamic result = await HttpCommandExecutor.Execute<Parameters, dynamic>(
       "GetWindowData",
-      new Parameters(ApplicationIds, SendProperties, SendListingParameters)
+      new Parameters(ApplicationIds, SendProperties, SendListingParameters, true)
     );
 
-    return (Speckle.Newtonsoft.Json.Linq.JArray)result["windows"];
+    return ExpandDictionaries((Speckle.Newtonsoft.Json.Linq.JObject)result, "windows");
   }
 }
@@ -0,0 +1,22 @@
+using System.Threading.Tasks;
+using Speckle.Newtonsoft.Json;
+
+namespace Archicad.Communication.Commands;
+
+/// <summary>
+/// Removes the generated library parts no placed object uses any more from the embedded library.
+/// </summary>
+internal sealed class RemoveUnusedLibraryParts : ICommand<object>
+{
+  [JsonObject(MemberSerialization.OptIn)]
+  public sealed class Parameters { }
+
+  [JsonObject(MemberSerialization.OptIn)]
+  private sealed class Result { }
+
+  public async Task<object> Execute()
+  {
+    Result result = await HttpCommandExecutor.Execute<Parameters, Result>("RemoveUnusedLibraryParts", new Parameters());
+    return result;
+  }
+}
@@ -0,0 +1,19 @@
+using System;
+using System.Collections.Generic;
+using Speckle.Core.Models;
+
+namespace Archicad.Communication;
+
+/// <summary>
+/// The user cancelled the creation of the elements in Archicad, the elements processed before are kept.
+/// </summary>
+public sealed class CreateCancelledException : OperationCanceledException
+{
+  public IEnumerable<ApplicationObject> ApplicationObjects { get; }
+
+  public CreateCancelledException(IEnumerable<ApplicationObject> applicationObjects)
+    : base("The receive was cancelled in Archicad.")
+  {
+    ApplicationObjects = applicationObjects ?? new List<ApplicationObject>();
+  }
+}
@@ -0,0 +1,39 @@
+using System.Collections.Generic;
+using Speckle.Core.Models;
+using Speckle.Newtonsoft.Json;
+
+namespace Archicad.Communication;
+
+/// <summary>
+/// Result of the commands creating elements, the add-on stops and sets cancelled when the user cancels it in Archicad.
+/// </summary>
+[JsonObject(MemberSerialization.OptIn)]
+internal sealed class CreateCommandResult
+{
+  #region --- Fields ---
+
+  [JsonProperty("applicationObjects")]
+  public IEnumerable<ApplicationObject> ApplicationObjects { get; private set; }
+
+  [JsonProperty("cancelled")]
+  public bool Cancelled { get; private set; }
+
+  #endregion
+
+  #region --- Functions ---
+
+  /// <summary>
+  /// The results of the processed elements, throws with them when the creation was cancelled.
+  /// </summary>
+  public IEnumerable<ApplicationObject> GetApplicationObjects()
+  {
+    if (Cancelled)
+    {
+      throw new CreateCancelledException(ApplicationObjects);
+    }
+
+    return ApplicationObjects;
+  }
+
+  #endregion
+}
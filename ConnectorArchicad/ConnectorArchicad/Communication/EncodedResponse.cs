@@ -0,0 +1,87 @@
+using System;
+using System.IO;
+using System.IO.Compression;
+using Speckle.Newtonsoft.Json;
+
+namespace Archicad.Communication;
+
+/// <summary>
+/// Compressed envelope of a command response: the deflated JSON of the response, base64 encoded,
+/// with the size and the Adler-32 checksum of the uncompressed JSON.
+/// </summary>
+[JsonObject(MemberSerialization.OptIn)]
+internal sealed class EncodedResponse
+{
+  #region --- Fields ---
+
+  public const string Deflate = "deflate";
+
+  [JsonProperty("encoding")]
+  public string Encoding { get; private set; }
+
+  [JsonProperty("payload")]
+  private string Payload { get; set; }
+
+  [JsonProperty("size")]
+  private long Size { get; set; }
+
+  [JsonProperty("checksum")]
+  private uint Checksum { get; set; }
+
+  #endregion
+
+  #region --- Functions ---
+
+  /// <summary>
+  /// Inflates the payload, the returned stream holds the UTF-8 JSON of the response.
+  /// </summary>
+  public Stream Decode()
+  {
+    if (Encoding != Deflate)
+    {
+      throw new InvalidDataException($"Unsupported response encoding: {Encoding}");
+    }
+
+    MemoryStream json = new(Size > 0 && Size <= int.MaxValue ? (int)Size : 0);
+    using (MemoryStream input = new(Convert.FromBase64String(Payload)))
+    using (DeflateStream deflate = new(input, CompressionMode.Decompress))
+    {
+      deflate.CopyTo(json);
+    }
+
+    if (json.Length != Size || Adler32(json.GetBuffer(), (int)json.Length) != Checksum)
+    {
+      throw new InvalidDataException("The decoded response does not match its size or checksum.");
+    }
+
+    json.Position = 0;
+    return json;
+  }
+
+  private static uint Adler32(byte[] data, int length)
+  {
+    // the sums can't overflow in this many steps before the modulo
+    const int blockSize = 5552;
+    const uint modulo = 65521;
+
+    uint a = 1;
+    uint b = 0;
+    int i = 0;
+    while (i < length)
+    {
+      int blockEnd = Math.Min(length, i + blockSize);
+      for (; i < blockEnd; i++)
+      {
+        a += data[i];
+        b += a;
+      }
+
+      a %= modulo;
+      b %= modulo;
+    }
+
+    return (b << 16) | a;
+  }
+
+  #endregion
+}
@@ -1,7 +1,10 @@
 using System;
+using System.IO;
 using System.Runtime.Serialization;
+using System.Text;
 using System.Threading.Tasks;
 using Speckle.Newtonsoft.Json;
+using Speckle.Newtonsoft.Json.Linq;
 
 namespace Archicad.Communication;
 
@@ -21,11 +24,62 @@ internal static class HttpCommandExecutor
     return JsonConvert.SerializeObject(request, settings);
   }
 
+  private static JsonSerializerSettings CreateResponseSettings()
+  {
+    return new()
+    {
+      Context = new StreamingContext(StreamingContextStates.Remoting),
+      Converters = { new PointUnitsConverter() }
+    };
+  }
+
   private static TResponse DeserializeResponse<TResponse>(string obj)
   {
-    JsonSerializerSettings settings = new() { Context = new StreamingContext(StreamingContextStates.Remoting) };
+    return JsonConvert.DeserializeObject<TResponse>(obj, CreateResponseSettings());
+  }
+
+  /// <summary>
+  /// Parses the inflated JSON of an encoded response while it is read, it is never held as a string.
+  /// </summary>
+  private static JToken DeserializeResponse(Stream stream)
+  {
+    using StreamReader reader = new(stream, Encoding.UTF8);
+    using JsonTextReader jsonReader = new(reader);
+
+    return JToken.ReadFrom(jsonReader);
+  }
+
+  /// <summary>
+  /// The add-on stops collecting the data and sets cancelled when the user cancels it in Archicad,
+  /// the partial result is never converted, the send is cancelled instead.
+  /// </summary>
+  private static TResult ToResult<TResult>(JToken result)
+  {
+    if (result is JObject obj && (bool?)obj["cancelled"] == true)
+    {
+      throw new OperationCanceledException("The send was cancelled in Archicad.");
+    }
+
+    if (result is TResult token)
+    {
+      return token;
+    }
+
+    return result?.ToObject<TResult>(JsonSerializer.Create(CreateResponseSettings()));
+  }
+
+  private static TResult DeserializeEncodedResult<TResult>(string obj)
+  {
+    JToken result = DeserializeResponse<AddOnCommandResponse<JToken>>(obj).Result;
 
-    return JsonConvert.DeserializeObject<TResponse>(obj, settings);
+    // the add-on sends the response as it is when it could not encode it
+    if (result is not JObject envelope || envelope["encoding"] == null)
+    {
+      return ToResult<TResult>(result);
+    }
+
+    using Stream json = envelope.ToObject<EncodedResponse>().Decode();
+    return ToResult<TResult>(DeserializeResponse(json));
   }
 
   public static async Task<TResult> Execute<TParameters, TResult>(string commandName, TParameters parameters)
@@ -65,6 +119,11 @@ internal static class HttpCommandExecutor
         Console.WriteLine(responseMsg);
       }
 
+      if (parameters is IEncodedResponseParameters { ResponseEncoding: not null })
+      {
+        return DeserializeEncodedResult<TResult>(responseMsg);
+      }
+
       AddOnCommandResponse<TResult> response = DeserializeResponse<AddOnCommandResponse<TResult>>(responseMsg);
 
       // TODO
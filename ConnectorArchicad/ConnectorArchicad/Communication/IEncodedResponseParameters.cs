@@ -0,0 +1,9 @@
+namespace Archicad.Communication;
+
+/// <summary>
+/// Parameters of the commands which can send their response in a compressed envelope.
+/// </summary>
+internal interface IEncodedResponseParameters
+{
+  string ResponseEncoding { get; }
+}
@@ -0,0 +1,47 @@
+using System;
+using Objects.Geometry;
+using Speckle.Core.Kits;
+using Speckle.Newtonsoft.Json;
+using Speckle.Newtonsoft.Json.Linq;
+
+namespace Archicad.Communication;
+
+/// <summary>
+/// The add-on sends points as plain coordinates in meters, the units are not repeated for every point.
+/// </summary>
+internal sealed class PointUnitsConverter : JsonConverter<Point>
+{
+  #region --- Functions ---
+
+  public override bool CanWrite => false;
+
+  public override Point ReadJson(
+    JsonReader reader,
+    Type objectType,
+    Point existingValue,
+    bool hasExistingValue,
+    JsonSerializer serializer
+  )
+  {
+    if (reader.TokenType == JsonToken.Null)
+    {
+      return null;
+    }
+
+    JObject jObject = JObject.Load(reader);
+
+    return new Point(
+      jObject.Value<double>("x"),
+      jObject.Value<double>("y"),
+      jObject.Value<double>("z"),
+      jObject.Value<string>("units") ?? Units.Meters
+    );
+  }
+
+  public override void WriteJson(JsonWriter writer, Point value, JsonSerializer serializer)
+  {
+    throw new NotSupportedException();
+  }
+
+  #endregion
+}
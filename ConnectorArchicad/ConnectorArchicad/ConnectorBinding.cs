@@ -119,6 +119,15 @@ public partial class ArchicadBinding : ConnectorBindings
           "Lamp"
         },
         Description = "Adds all elements with the selected Element Types"
+      },
+      new PropertySelectionFilter
+      {
+        Slug = "filterExpression",
+        Name = "Layer or Story",
+        Icon = "FilterList",
+        Values = new List<string> { "Layer", "Story" },
+        Operators = new List<string> { "equals" },
+        Description = "Adds all elements on the layer of the given name, or on the story of the given index"
       }
     };
   }
@@ -166,6 +175,12 @@ public partial class ArchicadBinding : ConnectorBindings
 
         await AsyncCommandProcessor.Execute(new Communication.Commands.FinishReceiveTransaction());
 
+        // the parts of the objects replaced by this receive are not used any more
+        if (commitObject is not null)
+        {
+          await AsyncCommandProcessor.Execute(new Communication.Commands.RemoveUnusedLibraryParts());
+        }
+
         if (commitObject == null)
         {
           timer.Cancel();
@@ -25,6 +25,10 @@ public class ConversionOptions
           ReceiveParametric = ((CheckBoxSetting)setting).IsChecked;
           break;
 
+        case (int)SettingSlugs.SendChangedElementsOnly:
+          SendChangedElementsOnly = ((CheckBoxSetting)setting).IsChecked;
+          break;
+
         default:
           break;
       }
@@ -34,4 +38,5 @@ public class ConversionOptions
   public bool SendProperties { get; set; }
   public bool SendListingParameters { get; set; }
   public bool ReceiveParametric { get; set; }
+  public bool SendChangedElementsOnly { get; set; }
 }
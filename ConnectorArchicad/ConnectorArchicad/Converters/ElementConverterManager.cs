@@ -1,15 +1,18 @@
 using System;
 using System.Collections.Generic;
+using System.Globalization;
 using System.Linq;
 using System.Reflection;
 using System.Threading;
 using System.Threading.Tasks;
 using Archicad.Communication;
 using DesktopUI2.Models;
+using DesktopUI2.Models.Filters;
 using DesktopUI2.ViewModels;
 using Objects.BuiltElements.Archicad;
 using Speckle.Core.Logging;
 using Speckle.Core.Models;
+using Speckle.Newtonsoft.Json.Linq;
 using Beam = Objects.BuiltElements.Beam;
 using Ceiling = Objects.BuiltElements.Ceiling;
 using Column = Objects.BuiltElements.Column;
@@ -38,6 +41,7 @@ public sealed partial class ElementConverterManager
 
   private Dictionary<Type, IEnumerable<Base>> ReceivedObjects { get; set; }
   private Dictionary<string, IEnumerable<string>> SelectedObjects { get; set; }
+  private SendCache SendCache { get; } = new();
 
   private List<string> CanHaveSubElements = new() { "Wall", "Roof", "Shell" }; // Hardcoded until we know whats the shared property that defines wether elements may be have subelements or not.
   #endregion
@@ -59,27 +63,50 @@ public sealed partial class ElementConverterManager
 
     var conversionOptions = new ConversionOptions(state.Settings);
 
-    IEnumerable<string> elementIds = state.Filter.Selection;
+    if (conversionOptions.SendChangedElementsOnly)
+    {
+      await SendCache.Update(conversionOptions, progress.CancellationToken);
+    }
+    else
+    {
+      SendCache.Clear();
+    }
+
+    // the add-on groups the listed ids by type in the same call, only an explicit selection needs GetElementTypes
     if (state.Filter.Slug == "all")
     {
-      elementIds = AsyncCommandProcessor
-        .Execute(new Communication.Commands.GetElementIds(Communication.Commands.GetElementIds.ElementFilter.All))
-        ?.Result;
+      SelectedObjects = await AsyncCommandProcessor.Execute(
+        new Communication.Commands.GetElementIdsByType(Communication.Commands.GetElementIds.ElementFilter.All),
+        progress.CancellationToken
+      );
     }
     else if (state.Filter.Slug == "elementType")
     {
       var elementTypes = state.Filter.Summary.Split(",").Select(elementType => elementType.Trim()).ToList();
-      elementIds = AsyncCommandProcessor
-        .Execute(
-          new Communication.Commands.GetElementIds(
-            Communication.Commands.GetElementIds.ElementFilter.ElementType,
-            elementTypes
-          )
-        )
-        ?.Result;
+      SelectedObjects = await AsyncCommandProcessor.Execute(
+        new Communication.Commands.GetElementIdsByType(
+          Communication.Commands.GetElementIds.ElementFilter.ElementType,
+          elementTypes
+        ),
+        progress.CancellationToken
+      );
+    }
+    else if (state.Filter is PropertySelectionFilter propertyFilter && state.Filter.Slug == "filterExpression")
+    {
+      SelectedObjects = await AsyncCommandProcessor.Execute(
+        new Communication.Commands.GetElementIdsByType(
+          Communication.Commands.GetElementIds.ElementFilter.All,
+          null,
+          GetFilterExpression(propertyFilter)
+        ),
+        progress.CancellationToken
+      );
+    }
+    else
+    {
+      SelectedObjects = await GetElementsType(state.Filter.Selection, progress.CancellationToken); // Gets all selected objects
     }
 
-    SelectedObjects = await GetElementsType(elementIds, progress.CancellationToken); // Gets all selected objects
     SelectedObjects = SortSelectedObjects();
 
     SpeckleLog.Logger.Debug("Conversion started (element types: {0})", SelectedObjects.Count);
@@ -88,6 +115,8 @@ public sealed partial class ElementConverterManager
     progress.Value = 0;
 
     List<Base> allObjects = new();
+    // the parents reused from the previous send still have the subelements of that send
+    HashSet<Base> parentsWithSubelements = new();
     foreach (var (element, guids) in SelectedObjects) // For all kind of selected objects (like window, door, wall, etc.)
     {
       SpeckleLog.Logger.Debug("{0}: {1}", element, guids.Count());
@@ -130,7 +159,7 @@ public sealed partial class ElementConverterManager
           }
           else
           {
-            if (parent["elements"] == null)
+            if (parentsWithSubelements.Add(parent))
             {
               parent["elements"] = new List<Base>() { item };
             }
@@ -157,6 +186,27 @@ public sealed partial class ElementConverterManager
     return objectToCommit;
   }
 
+  /// <summary>
+  /// The filter expression the add-on tests the elements with, see ElementFilter in the add-on.
+  /// </summary>
+  private static JObject GetFilterExpression(PropertySelectionFilter filter)
+  {
+    switch (filter.PropertyName)
+    {
+      case "Layer":
+        return new JObject { ["layers"] = new JArray(filter.PropertyValue) };
+      case "Story":
+        if (!int.TryParse(filter.PropertyValue, NumberStyles.Integer, CultureInfo.InvariantCulture, out int floorIndex))
+        {
+          throw new InvalidOperationException($"The story index {filter.PropertyValue} is not a whole number.");
+        }
+
+        return new JObject { ["floors"] = new JObject { ["from"] = floorIndex, ["to"] = floorIndex } };
+      default:
+        throw new InvalidOperationException($"Elements can't be filtered by {filter.PropertyName}.");
+    }
+  }
+
   Dictionary<string, IEnumerable<string>> SortSelectedObjects()
   {
     var retval = new Dictionary<string, IEnumerable<string>>();
@@ -296,13 +346,38 @@ public sealed partial class ElementConverterManager
     ConversionOptions conversionOptions
   )
   {
-    var rawModels = await GetModelForElements(applicationIds, progress.CancellationToken); // Model data, like meshes
-    var elementConverter = ElementConverterManager.Instance.GetConverterForElement(elementType, null, false); // Object converter
-    var convertedObjects = await elementConverter.ConvertToSpeckle(
-      rawModels,
-      progress.CancellationToken,
-      conversionOptions
-    ); // Deserialization
+    // the elements unchanged since the previous send are not converted again
+    List<string> changedApplicationIds = new();
+    List<Base> convertedObjects = new();
+    foreach (string applicationId in applicationIds)
+    {
+      if (conversionOptions.SendChangedElementsOnly && SendCache.TryGetElement(applicationId, out Base unchangedObject))
+      {
+        convertedObjects.Add(unchangedObject);
+      }
+      else
+      {
+        changedApplicationIds.Add(applicationId);
+      }
+    }
+
+    if (changedApplicationIds.Count > 0)
+    {
+      var rawModels = await GetModelForElements(changedApplicationIds, progress.CancellationToken); // Model data, like meshes
+      var elementConverter = ElementConverterManager.Instance.GetConverterForElement(elementType, null, false); // Object converter
+      var changedObjects = await elementConverter.ConvertToSpeckle(
+        rawModels,
+        progress.CancellationToken,
+        conversionOptions
+      ); // Deserialization
+
+      if (conversionOptions.SendChangedElementsOnly)
+      {
+        changedObjects.ForEach(SendCache.AddElement);
+      }
+
+      convertedObjects.AddRange(changedObjects);
+    }
 
     foreach (Base convertedObject in convertedObjects)
     {
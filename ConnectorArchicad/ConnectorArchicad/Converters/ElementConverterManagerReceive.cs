@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Threading;
 using System.Threading.Tasks;
+using Archicad.Communication;
 using DesktopUI2.Models;
 using DesktopUI2.ViewModels;
 using Objects.Converter.Archicad;
@@ -55,31 +56,35 @@ public sealed partial class ElementConverterManager
       SpeckleLog.Logger.Debug("{0}: {1}", elementType, tc.Count<TraversalContext>());
 
       List<Base> elements = tc.Select(tc => tc.current).ToList<Base>();
-      var convertedElements = await ConvertOneTypeToNative(
-        elementType,
-        tc,
-        converter.ConversionOptions,
-        progress.CancellationTokenSource.Token
-      );
-
-      if (convertedElements != null)
+      List<ApplicationObject> convertedElements;
+      try
       {
-        var dict = convertedElements
-          .Where(obj => (!string.IsNullOrEmpty(obj.OriginalId)))
-          .ToDictionary(obj => obj.OriginalId, obj => obj);
-
-        progress.Value += convertedElements.Count();
-
+        convertedElements = await ConvertOneTypeToNative(
+          elementType,
+          tc,
+          converter.ConversionOptions,
+          progress.CancellationTokenSource.Token
+        );
+      }
+      catch (CreateCancelledException ex)
+      {
+        // the elements created before the cancel are kept, the rest are reported as not processed
+        UpdateContextObjects(ex.ApplicationObjects, converter, progress);
         foreach (var contextObject in converter.ContextObjects)
         {
-          if (dict.ContainsKey(contextObject.OriginalId))
+          if (contextObject.Status == ApplicationObject.State.Unknown)
           {
-            ApplicationObject obj = dict[contextObject.OriginalId];
-
-            contextObject.Update(status: obj.Status, createdIds: obj.CreatedIds, log: obj.Log);
+            contextObject.Update(status: ApplicationObject.State.Skipped, logItem: "Not processed, " + ex.Message);
             progress.Report.UpdateReportObject(contextObject);
           }
         }
+
+        throw;
+      }
+
+      if (convertedElements != null)
+      {
+        UpdateContextObjects(convertedElements, converter, progress);
       }
     }
 
@@ -88,6 +93,30 @@ public sealed partial class ElementConverterManager
     return true;
   }
 
+  private static void UpdateContextObjects(
+    IEnumerable<ApplicationObject> convertedElements,
+    ConverterArchicad converter,
+    ProgressViewModel progress
+  )
+  {
+    var dict = convertedElements
+      .Where(obj => (!string.IsNullOrEmpty(obj.OriginalId)))
+      .ToDictionary(obj => obj.OriginalId, obj => obj);
+
+    progress.Value += convertedElements.Count();
+
+    foreach (var contextObject in converter.ContextObjects)
+    {
+      if (dict.ContainsKey(contextObject.OriginalId))
+      {
+        ApplicationObject obj = dict[contextObject.OriginalId];
+
+        contextObject.Update(status: obj.Status, createdIds: obj.CreatedIds, log: obj.Log);
+        progress.Report.UpdateReportObject(contextObject);
+      }
+    }
+  }
+
   public async Task<bool> ConvertToNative(StreamState state, Base commitObject, ProgressViewModel progress)
   {
     ConversionOptions conversionOptions = new(state.Settings);
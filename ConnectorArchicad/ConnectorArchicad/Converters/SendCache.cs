@@ -0,0 +1,84 @@
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using System.Threading.Tasks;
+using Archicad.Communication;
+using Speckle.Core.Models;
+
+namespace Archicad;
+
+/// <summary>
+/// The converted elements of the previous sends, reused while the change journal of the add-on reports them unchanged.
+/// Changes of attributes (layers, stories, materials) are not element changes, the elements using them are not converted again.
+/// </summary>
+internal sealed class SendCache
+{
+  #region --- Fields ---
+
+  private string JournalId { get; set; }
+  private ulong Sequence { get; set; }
+  private bool SendProperties { get; set; }
+  private bool SendListingParameters { get; set; }
+
+  private Dictionary<string, Base> Elements { get; } = new();
+
+  #endregion
+
+  #region --- Functions ---
+
+  /// <summary>
+  /// Drops the elements changed since the previous send, or all of them when the changes are not known.
+  /// The sequence is taken before the elements are converted, a change during the send is dropped by the next one.
+  /// </summary>
+  public async Task Update(ConversionOptions conversionOptions, CancellationToken token)
+  {
+    var changes = await AsyncCommandProcessor.Execute(
+      new Communication.Commands.GetChangesSince(JournalId, Sequence),
+      token
+    );
+
+    if (
+      changes == null
+      || changes.Overflow
+      || conversionOptions.SendProperties != SendProperties
+      || conversionOptions.SendListingParameters != SendListingParameters
+    )
+    {
+      Elements.Clear();
+    }
+    else
+    {
+      foreach (string applicationId in changes.Modified.Concat(changes.Deleted))
+      {
+        Elements.Remove(applicationId);
+      }
+    }
+
+    JournalId = changes?.JournalId;
+    Sequence = changes?.Sequence ?? 0;
+    SendProperties = conversionOptions.SendProperties;
+    SendListingParameters = conversionOptions.SendListingParameters;
+  }
+
+  public bool TryGetElement(string applicationId, out Base element)
+  {
+    return Elements.TryGetValue(applicationId, out element);
+  }
+
+  public void AddElement(Base element)
+  {
+    if (!string.IsNullOrEmpty(element.applicationId))
+    {
+      Elements[element.applicationId] = element;
+    }
+  }
+
+  public void Clear()
+  {
+    Elements.Clear();
+    JournalId = null;
+    Sequence = 0;
+  }
+
+  #endregion
+}
@@ -1,6 +1,9 @@
+using System;
+using System.Threading;
 using Avalonia;
 using Avalonia.Controls;
 using Avalonia.ReactiveUI;
+using Avalonia.Threading;
 using DesktopUI2.ViewModels;
 using DesktopUI2.Views;
 using Speckle.Core.Logging;
@@ -12,9 +15,20 @@ class Program
   public static Window? MainWindow { get; private set; }
   public static ArchicadBinding? Bindings { get; set; }
 
+  /// <summary>
+  /// Started by the add-on in advance, the window is shown when the add-on asks for it through the heartbeat.
+  /// </summary>
+  private static bool StartHidden { get; set; }
+
+  /// <summary>
+  /// Polled quickly until the add-on has seen the connector, then only often enough to notice a menu click.
+  /// </summary>
+  private static readonly TimeSpan HandshakeInterval = TimeSpan.FromMilliseconds(500);
+  private static readonly TimeSpan HeartbeatInterval = TimeSpan.FromSeconds(1);
+
   public static void Main(string[] args)
   {
-    if (args.Length != 2)
+    if (args.Length != 2 && args.Length != 3)
     {
       System.Diagnostics.Debug.Fail("Communication port number is missing!");
       return;
@@ -32,6 +46,8 @@ class Program
       return;
     }
 
+    StartHidden = args.Length == 3 && args[2] == "hidden";
+
     Communication.ConnectionManager.Instance.Start(portNumber);
 
     Bindings = new ArchicadBinding(archicadVersion);
@@ -64,6 +80,47 @@ class Program
     var viewModel = new MainViewModel(Bindings);
     MainWindow = new MainWindow { DataContext = viewModel, CancelClosing = false };
 
-    app.Run(MainWindow);
+    if (!StartHidden)
+    {
+      app.Run(MainWindow);
+      return;
+    }
+
+    // the window is not shown yet, the application ends when it gets closed
+    CancellationTokenSource exit = new();
+    MainWindow.Closed += (_, _) => exit.Cancel();
+
+    DispatcherTimer heartbeat = new() { Interval = HandshakeInterval };
+    heartbeat.Tick += async (_, _) =>
+    {
+      heartbeat.Stop();
+
+      Communication.Commands.ConnectorHeartbeat.Result? result = null;
+      try
+      {
+        result = await Communication.AsyncCommandProcessor.Execute(new Communication.Commands.ConnectorHeartbeat());
+      }
+      catch (Exception ex) when (!ex.IsFatal())
+      {
+        SpeckleLog.Logger.Warning(ex, "Heartbeat to Archicad failed");
+      }
+
+      if (result is { Show: true })
+      {
+        MainWindow.Show();
+        MainWindow.Activate();
+        return;
+      }
+
+      if (result is not null)
+      {
+        heartbeat.Interval = HeartbeatInterval;
+      }
+
+      heartbeat.Start();
+    };
+    heartbeat.Start();
+
+    app.Run(exit.Token);
   }
 }
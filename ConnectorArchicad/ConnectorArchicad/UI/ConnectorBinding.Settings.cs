@@ -9,14 +9,16 @@ public partial class ArchicadBinding
   {
     SendProperties = 0,
     SendListingParameters = 1,
-    ReceiveParametric = 2
+    ReceiveParametric = 2,
+    SendChangedElementsOnly = 3
   }
 
   public static string[] settingSlugs =
   {
     "filter - properties",
     "filter - listing parameters",
-    "receive - parametric"
+    "receive - parametric",
+    "send - changed elements only"
   };
 
   public override List<ISetting> GetSettings()
@@ -47,6 +49,14 @@ public partial class ArchicadBinding
         IsChecked = false,
         Description = "Receive parametric elements where applicable"
       },
+      new CheckBoxSetting
+      {
+        Slug = settingSlugs[(int)SettingSlugs.SendChangedElementsOnly],
+        Name = "Send changed elements only",
+        Icon = "Link",
+        IsChecked = false,
+        Description = "Convert only the elements changed since the previous send, attribute changes are not detected"
+      },
     };
   }
 }